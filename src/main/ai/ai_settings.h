@@ -1,7 +1,30 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include "transposition_table.h"
+
+enum class SearchStrategy {
+    RootSplit,
+    LazySmp,
+    Ybwc,
+    Abdada,
+};
+
 struct AiSettings {
     const bool useThreading;
+    const SearchStrategy searchStrategy = SearchStrategy::RootSplit;
+    // the threads searching at once, 0 for one per hardware thread; just one without useThreading
+    const int threadCount = 0;
+    // in megabytes
+    const size_t transpositionTableSize = TranspositionTable::defaultSize;
+
+    int getThreadCount() const {
+        if (!useThreading) return 1;
+        if (threadCount > 0) return threadCount;
+        return std::max(1, (int) std::thread::hardware_concurrency());
+    }
 };
 
 const AiSettings debugAiSettings{false};
@@ -5,10 +5,6 @@
 struct AnalysisInfo {
     const unsigned long positionsAnalyzed;
     const int depthSearchedTo;
-    const Move *move;
+    const Move move;
     long millisElapsed;
-
-    ~AnalysisInfo() {
-        delete move;
-    }
 };
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+#include <tbb/task_group.h>
+
+// a stop request polled by every thread of a search, so it sits on a cache line of its own
+class alignas(64) CancellationToken {
+public:
+    void cancel() {
+        cancelled.store(true, std::memory_order_relaxed);
+        context.cancel_group_execution();
+    }
+
+    // only once nothing searches with the token any more
+    void reset() {
+        cancelled.store(false, std::memory_order_relaxed);
+        context.reset();
+    }
+
+    bool isCancelled() const {
+        return cancelled.load(std::memory_order_relaxed);
+    }
+
+    tbb::task_group_context &getContext() {
+        return context;
+    }
+
+private:
+    std::atomic<bool> cancelled = false;
+    tbb::task_group_context context;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <climits>
+#include <cstdint>
+#include "constants.h"
+
+// checkmate scores are kept as distances from the ends of the 32-bit range, in the same order
+namespace CompressedEval {
+    const int64_t edgeRange = 1 << 20;
+
+    inline int32_t compress(Eval value) {
+        if (value < EvalValues::min + edgeRange) return INT32_MIN + (int32_t) (value - EvalValues::min);
+        if (value > EvalValues::max - edgeRange) return INT32_MAX - (int32_t) (EvalValues::max - value);
+        return (int32_t) value;
+    }
+
+    inline Eval decompress(int32_t value) {
+        if (value < INT32_MIN + edgeRange) return EvalValues::min + ((int64_t) value - INT32_MIN);
+        if (value > INT32_MAX - edgeRange) return EvalValues::max - (INT32_MAX - (int64_t) value);
+        return value;
+    }
+}
@@ -0,0 +1,75 @@
+#include "abdada.h"
+#include <thread>
+#include <vector>
+#include "ai/single_depth_move_generator.h"
+
+namespace DeepEvaluationStrategy {
+    Abdada::Abdada(SingleDepthMoveGenerator *generator, bool startsHelpers)
+            : Sequential(generator), startsHelpers(startsHelpers) {}
+
+    int64_t Abdada::_deepEvaluate(Board *board, MovePicker &picker, int depth, int64_t alpha, int64_t beta, Move &bestMove) const {
+        if (!startsHelpers) return search(board, picker, depth, alpha, beta, bestMove);
+
+        std::vector<SingleDepthMoveGenerator *> helpers;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < generator->threadCount - 1; i++) {
+            auto helperBoard = board->copy();
+            auto helper = new SingleDepthMoveGenerator(generator->parent, helperBoard, depth, 1);
+            helpers.push_back(helper);
+
+            threads.emplace_back([helper, helperBoard, depth, alpha, beta]() {
+                helper->abdadaSearchStrategy->deepEvaluate(helperBoard, depth, alpha, beta);
+            });
+        }
+
+        auto evaluation = search(board, picker, depth, alpha, beta, bestMove);
+
+        for (auto helper: helpers) helper->isStopped = true;
+
+        for (size_t i = 0; i < threads.size(); i++) {
+            threads[i].join();
+            delete helpers[i]->board;
+            delete helpers[i];
+        }
+
+        return evaluation;
+    }
+
+    int64_t Abdada::search(Board *board, MovePicker &picker, int depth, int64_t alpha, int64_t beta, Move &bestMove) const {
+        bool shouldExit = false;
+        bool isFirstMove = true;
+        MoveList deferredMoves;
+
+        for (auto move = picker.next(); !move.isNull(); move = picker.next()) {
+            auto isDeferred = !isFirstMove && depth >= minDeferDepth
+                              && generator->transpositions->isBeingSearched(board->getZobristHashAfter(move));
+
+            if (isDeferred) {
+                deferredMoves.push(move);
+                continue;
+            }
+
+            searchMove(board, move, depth, isFirstMove, alpha, beta, shouldExit, bestMove);
+            isFirstMove = false;
+            if (shouldExit || shouldStop()) return alpha;
+        }
+
+        for (auto move: deferredMoves) {
+            searchMove(board, move, depth, false, alpha, beta, shouldExit, bestMove);
+            if (shouldExit || shouldStop()) return alpha;
+        }
+
+        return alpha;
+    }
+
+    void Abdada::searchMove(Board *board, Move move, int depth, bool isFirstMove,
+                            int64_t &alpha, int64_t &beta, bool &shouldExit, Move &bestMove) const {
+        auto childHash = board->getZobristHashAfter(move);
+        auto isMarked = depth >= minDeferDepth;
+
+        if (isMarked) generator->transpositions->markBeingSearched(childHash);
+        deepEvaluateMove(board, move, depth, alpha, beta, shouldExit, bestMove, strategy,
+                         generator->abdadaSearchStrategy, !isFirstMove);
+        if (isMarked) generator->transpositions->unmarkBeingSearched(childHash);
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "sequential.h"
+
+class SingleDepthMoveGenerator;
+
+namespace DeepEvaluationStrategy {
+    // ABDADA: threads defer the moves another thread is searching until they have searched the rest
+    class Abdada : public Sequential {
+    public:
+        explicit Abdada(SingleDepthMoveGenerator *generator, bool startsHelpers = true);
+
+        // below this depth no positions are marked, as a move searched twice costs little there
+        static const int minDeferDepth = 3;
+
+    private:
+        const bool startsHelpers;
+
+        int64_t _deepEvaluate(Board *board, MovePicker &picker, int depth, int64_t alpha, int64_t beta, Move &bestMove) const override;
+        int64_t search(Board *board, MovePicker &picker, int depth, int64_t alpha, int64_t beta, Move &bestMove) const;
+        void searchMove(Board *board, Move move, int depth, bool isFirstMove,
+                        int64_t &alpha, int64_t &beta, bool &shouldExit, Move &bestMove) const;
+    };
+}
@@ -5,11 +5,6 @@
 #include "ai/transposition_table.h"
 #include "ai/single_depth_move_generator.h"
 #include "ai/move_generator.h"
-#include "ai/move_sorting.h"
-
-bool shouldUpdateTransposition(int depth, int type, const Transposition &transposition) {
-    return depth > transposition.depth && transposition.type == type;
-}
 
 static int getNodeType(int64_t eval, int64_t alpha, int64_t beta) {
     if (eval >= beta) return Transposition::LOWER;
@@ -22,14 +17,49 @@ namespace DeepEvaluationStrategy {
             Board *board, int depth, int64_t alpha, int64_t beta,
             const DeepEvaluationStrategy::Base *furtherEvaluationStrategy
     ) const {
-        auto boardHash = board->getZobristHash();
+        return -furtherEvaluationStrategy->deepEvaluate(board, depth - 1, -beta, -alpha);
+    }
+
+    void Base::deepEvaluateMove(
+            Board *board, Move move, int depth,
+            int64_t &alpha, int64_t &beta, bool &shouldExit, Move &bestMove, EvaluationUpdateStrategy *strategy,
+            const Base *furtherEvaluationStrategy, bool triesNullWindow) const {
+        makeMove(board, move);
+        auto evaluation = triesNullWindow
+                          ? getEvaluation(board, depth, alpha, alpha + 1, furtherEvaluationStrategy)
+                          : getEvaluation(board, depth, alpha, beta, furtherEvaluationStrategy);
+
+        if (triesNullWindow && evaluation > alpha && evaluation < beta)
+            evaluation = getEvaluation(board, depth, alpha, beta, furtherEvaluationStrategy);
+
+        board->unmakeMove(move);
+
+        if (shouldStop()) return;
+
+        strategy->updateEvaluation(evaluation, move, shouldExit, alpha, beta, bestMove);
+        if (shouldExit) recordCutoff(move, depth);
+    }
 
-        TranspositionTable::const_accessor accessor;
-        auto isFound = generator->transpositions->find(accessor, boardHash);
+    void Base::makeMove(Board *board, Move move) const {
+        generator->transpositions->prefetch(board->getZobristHashAfter(move));
+        board->makeMoveWithoutGeneratingMoves(move);
+    }
 
-        if (isFound) {
-            auto transposition = (Transposition) *accessor->second;
+    void Base::recordCutoff(Move move, int depth) const {
+        generator->killerMoves.store(depth, move);
+    }
 
+    bool Base::shouldStop() const {
+        return generator->shouldStop();
+    }
+
+    // a deep enough entry answers right away, otherwise its best move is searched first
+    int64_t Base::deepEvaluate(Board *board, int depth, int64_t alpha, int64_t beta) const {
+        auto boardHash = board->getZobristHash();
+        Transposition transposition;
+        Move hashMove;
+
+        if (generator->transpositions->probe(boardHash, transposition)) {
             if (transposition.depth >= depth) {
                 if (transposition.type == Transposition::EXACT)
                     return transposition.value;
@@ -41,52 +71,34 @@ namespace DeepEvaluationStrategy {
                     return alpha;
             }
 
-            auto evaluation = -furtherEvaluationStrategy->deepEvaluate(board, depth - 1, -beta, -alpha);
-
-            int nodeType = getNodeType(evaluation, alpha, beta);
-
-            if (shouldUpdateTransposition(depth, nodeType, transposition))
-                accessor->second->exchange({evaluation, depth, nodeType});
-
-            return evaluation;
+            hashMove = transposition.bestMove;
         }
 
-        auto evaluation = -furtherEvaluationStrategy->deepEvaluate(board, depth - 1, -beta, -alpha);
+        Move bestMove;
+        auto evaluation = search(board, depth, alpha, beta, hashMove, bestMove);
 
-        AtomicTranspositionPtr ptr(
-                new std::atomic<Transposition>({evaluation, depth, getNodeType(evaluation, alpha, beta)}));
-        generator->transpositions->insert({{boardHash, ptr}});
+        if (!shouldStop())
+            generator->transpositions->store(boardHash, {evaluation, depth, getNodeType(evaluation, alpha, beta), bestMove});
 
         return evaluation;
     }
 
-    void Base::deepEvaluateMove(
-            Board *board, MoveVariant move, int depth,
-            int64_t &alpha, int64_t &beta, bool &shouldExit, EvaluationUpdateStrategy *strategy) const {
-        board->makeMoveWithoutGeneratingMoves(move);
-        auto evaluation = getEvaluation(board, depth, alpha, beta, generator->sequentialStrategy);
-        board->unmakeMove(move);
-        strategy->updateEvaluation(evaluation, shouldExit, alpha, beta);
-    }
-
-    int64_t Base::deepEvaluate(Board *board, int depth, int64_t alpha, int64_t beta) const {
+    int64_t Base::search(Board *board, int depth, int64_t alpha, int64_t beta, Move hashMove, Move &bestMove) const {
         if (depth == 0) {
-            generator->parent->positionsAnalyzed++;
+            generator->parent->positionsAnalyzed.fetch_add(1, std::memory_order_relaxed);
             return searchCaptures(board, alpha, beta);
         }
 
-        board->generateMoves();
+        auto &killers = generator->killerMoves;
+        MovePicker picker(board, hashMove, killers.get(depth, 0), killers.get(depth, 1));
 
-        if (board->legalMoves.empty()) {
-            generator->parent->positionsAnalyzed++;
+        if (!picker.hasMoves()) {
+            generator->parent->positionsAnalyzed.fetch_add(1, std::memory_order_relaxed);
             return evaluatePositionWithoutMoves(board, depth);
         }
 
-        auto moves = std::vector(board->legalMoves);
-        sortMoves(board, moves);
-
-        return _deepEvaluate(board, moves, depth, alpha, beta);
-    };
+        return _deepEvaluate(board, picker, depth, alpha, beta, bestMove);
+    }
 
     int64_t Base::getNullWindowEval(Board *board, int depth, int64_t alpha) const {
         return getEvaluation(board, depth, alpha, alpha + 1, generator->sequentialStrategy);
@@ -4,6 +4,7 @@
 #include "board/board.h"
 #include "ai/constants.h"
 #include "ai/evaluation_update_strategy.h"
+#include "ai/move_picker.h"
 
 class SingleDepthMoveGenerator;
 
@@ -12,6 +13,8 @@ namespace DeepEvaluationStrategy {
     public:
         int64_t deepEvaluate(Board *board, int depth, int64_t alpha = EvalValues::min, int64_t beta = EvalValues::max) const;
 
+        virtual ~Base() = default;
+
     protected:
         SingleDepthMoveGenerator *generator;
 
@@ -24,11 +27,23 @@ namespace DeepEvaluationStrategy {
 
         int64_t getNullWindowEval(Board *board, int depth, int64_t alpha) const;
 
+        // with triesNullWindow the move is searched with a full window only when it beats alpha
         void deepEvaluateMove(
-                Board *board, MoveVariant move, int depth,
-                int64_t &alpha, int64_t &beta, bool &shouldExit, EvaluationUpdateStrategy *strategy) const;
+                Board *board, Move move, int depth,
+                int64_t &alpha, int64_t &beta, bool &shouldExit, Move &bestMove, EvaluationUpdateStrategy *strategy,
+                const Base *furtherEvaluationStrategy, bool triesNullWindow = false) const;
+
+        void recordCutoff(Move move, int depth) const;
+
+        // a stopped search returns whatever it had so far, which must never be taken for a result
+        bool shouldStop() const;
+
+        void makeMove(Board *board, Move move) const;
 
     private:
-        virtual int64_t _deepEvaluate(Board *board, std::vector <MoveVariant> moves, int depth, int64_t alpha, int64_t beta) const = 0;
+        int64_t search(Board *board, int depth, int64_t alpha, int64_t beta, Move hashMove, Move &bestMove) const;
+
+        // bestMove is set to the move that raised alpha last, if any did
+        virtual int64_t _deepEvaluate(Board *board, MovePicker &picker, int depth, int64_t alpha, int64_t beta, Move &bestMove) const = 0;
     };
 }
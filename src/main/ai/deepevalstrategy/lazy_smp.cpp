@@ -0,0 +1,25 @@
+#include "lazy_smp.h"
+#include "ai/single_depth_move_generator.h"
+
+namespace DeepEvaluationStrategy {
+    LazySmp::LazySmp(MoveGenerator *parent, const Board *board, int helperCount) {
+        for (int i = 0; i < helperCount; i++) {
+            auto helper = new SingleDepthMoveGenerator(parent, board->copy(), 0, 1);
+            helpers.push_back(helper);
+            threads.emplace_back(runHelper, helper, i);
+        }
+    }
+
+    LazySmp::~LazySmp() {
+        for (size_t i = 0; i < threads.size(); i++) {
+            threads[i].join();
+            delete helpers[i]->board;
+            delete helpers[i];
+        }
+    }
+
+    void LazySmp::runHelper(SingleDepthMoveGenerator *helper, int index) {
+        for (int depth = 1 + index % 2; !helper->shouldStop(); depth++)
+            helper->pvsStrategy->deepEvaluate(helper->board, depth);
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include "board/board.h"
+
+class MoveGenerator;
+class SingleDepthMoveGenerator;
+
+namespace DeepEvaluationStrategy {
+    // Lazy SMP: helpers deepen on the position alongside the main search, sharing only the table
+    class LazySmp {
+    public:
+        LazySmp(MoveGenerator *parent, const Board *board, int helperCount);
+        // joins the helpers, so the search has to be cancelled first
+        ~LazySmp();
+
+        // every other helper starts a ply deeper, so that the threads spread over two depths
+        static void runHelper(SingleDepthMoveGenerator *helper, int index);
+
+    private:
+        std::vector<SingleDepthMoveGenerator *> helpers;
+        std::vector<std::thread> threads;
+    };
+}
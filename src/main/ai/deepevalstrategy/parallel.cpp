@@ -1,23 +1,53 @@
 #include "parallel.h"
+#include <algorithm>
 #include <tbb/parallel_for.h>
 #include "ai/single_depth_move_generator.h"
 #include "ai/move_generator.h"
 
 namespace DeepEvaluationStrategy {
-    int64_t Parallel::_deepEvaluate(Board *board, std::vector<MoveVariant> moves, int depth, int64_t alpha, int64_t beta) const {
-        bool shouldExit = false;
+    int64_t Parallel::_deepEvaluate(Board *board, MovePicker &picker, int depth, int64_t alpha, int64_t beta, Move &bestMove) const {
+        MoveList moves;
+        picker.collectRemaining(moves);
+
+        SharedBound sharedAlpha(alpha);
+        tbb::task_group_context context;
+
+        auto body = [this, board, &moves, depth, &sharedAlpha, beta, &context](tbb::blocked_range<size_t> range) {
+            UndoBuffer undoBuffer;
+            Board boardCopy(*board, undoBuffer);
 
-        auto body = [this, board, moves, depth, &alpha, &beta, &shouldExit](tbb::blocked_range<size_t> range) {
             for (size_t i = range.begin(); i < range.end(); ++i) {
-                if (shouldExit || generator->parent->analysisFinished) return;
-                auto boardCopy = board->copy();
-                deepEvaluateMove(boardCopy, moves[i], depth, alpha, beta, shouldExit, strategy);
-                delete boardCopy;
+                if (shouldStop()) return;
+                searchMove(&boardCopy, moves[i], depth, sharedAlpha, beta, context, generator->sequentialStrategy);
             }
         };
 
-        tbb::parallel_for(tbb::blocked_range<size_t>(0, moves.size()), body);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, moves.size()), body, context);
+
+        bestMove = sharedAlpha.getMove();
+        return sharedAlpha.getValue();
+    }
+
+    void Parallel::searchMove(
+            Board *board, Move move, int depth, SharedBound &alpha, int64_t beta,
+            tbb::task_group_context &context, const Base *furtherEvaluationStrategy) const {
+        makeMove(board, move);
+        auto evaluation = getEvaluation(board, depth, alpha.getValue(), beta, furtherEvaluationStrategy);
+        board->unmakeMove(move);
+
+        if (shouldStop()) return;
+
+        updateBound(evaluation, move, depth, alpha, beta, context);
+    }
+
+    void Parallel::updateBound(
+            int64_t evaluation, Move move, int depth, SharedBound &alpha, int64_t beta,
+            tbb::task_group_context &context) const {
+        alpha.raise(std::min(evaluation, beta), move);
 
-        return alpha;
+        if (evaluation >= beta) {
+            recordCutoff(move, depth);
+            context.cancel_group_execution();
+        }
     }
 }
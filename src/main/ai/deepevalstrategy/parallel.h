@@ -1,14 +1,24 @@
 #pragma once
 
+#include <tbb/task_group.h>
 #include "base.h"
+#include "ai/shared_bound.h"
 
 namespace DeepEvaluationStrategy {
+    // a beta cutoff cancels the context of the node, which stops everything below it
     class Parallel : public Base {
     public:
         explicit Parallel(SingleDepthMoveGenerator *generator): Base(generator) {}
 
-        ParallelizedUpdateStrategy *strategy = new ParallelizedUpdateStrategy();
+        int64_t _deepEvaluate(Board *board, MovePicker &picker, int depth, int64_t alpha, int64_t beta, Move &bestMove) const override;
 
-        int64_t _deepEvaluate(Board *board, std::vector<MoveVariant> moves, int depth, int64_t alpha, int64_t beta) const override;
+    protected:
+        void searchMove(
+                Board *board, Move move, int depth, SharedBound &alpha, int64_t beta,
+                tbb::task_group_context &context, const Base *furtherEvaluationStrategy) const;
+
+        void updateBound(
+                int64_t evaluation, Move move, int depth, SharedBound &alpha, int64_t beta,
+                tbb::task_group_context &context) const;
     };
 }
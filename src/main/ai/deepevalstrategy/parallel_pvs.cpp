@@ -1,43 +1,54 @@
 #include "parallel_pvs.h"
+#include <algorithm>
 #include <tbb/parallel_for.h>
 #include "ai/single_depth_move_generator.h"
 #include "ai/move_generator.h"
 
 namespace DeepEvaluationStrategy {
-    int64_t ParallelPvs::_deepEvaluate(Board *board, std::vector<MoveVariant> moves, int depth, int64_t alpha, int64_t beta) const {
-        bool shouldExit = false;
+    int64_t ParallelPvs::_deepEvaluate(Board *board, MovePicker &picker, int depth, int64_t alpha, int64_t beta, Move &bestMove) const {
+        auto firstMove = picker.next();
+        makeMove(board, firstMove);
+        auto firstMoveEval = getEvaluation(board, depth, alpha, beta, getFirstMoveEvaluationStrategy());
+        board->unmakeMove(firstMove);
+        bestMove = firstMove;
 
-        board->makeMoveWithoutGeneratingMoves(moves[0]);
-        alpha = getEvaluation(board, depth, alpha, beta, getFirstMoveEvaluationStrategy());
-        board->unmakeMove(moves[0]);
+        if (firstMoveEval >= beta) {
+            recordCutoff(firstMove, depth);
+            return beta;
+        }
+
+        MoveList moves;
+        picker.collectRemaining(moves);
+
+        SharedBound sharedAlpha(std::max(alpha, firstMoveEval), firstMove);
+        tbb::task_group_context context;
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, moves.size()),
+                          [&moves, board, depth, this, &sharedAlpha, beta, &context](tbb::blocked_range<size_t> range) {
+                              UndoBuffer undoBuffer;
+                              Board boardCopy(*board, undoBuffer);
 
-        tbb::parallel_for(tbb::blocked_range<size_t>(1, moves.size()),
-                          [moves, board, depth, &shouldExit, this, &alpha, &beta](tbb::blocked_range<size_t> range) {
                               for (size_t i = range.begin(); i < range.end(); i++) {
-                                  auto initialAlpha = alpha;
-                                  auto boardCopy = board->copy();
+                                  if (shouldStop()) return;
+
+                                  auto initialAlpha = sharedAlpha.getValue();
                                   auto moveCopy = moves[i];
-                                  boardCopy->makeMoveWithoutGeneratingMoves(moveCopy);
-                                  auto nullWindowEval = getNullWindowEval(boardCopy, depth, initialAlpha);
-                                  boardCopy->unmakeMove(moveCopy);
+                                  makeMove(&boardCopy, moveCopy);
+                                  auto nullWindowEval = getNullWindowEval(&boardCopy, depth, initialAlpha);
+                                  boardCopy.unmakeMove(moveCopy);
 
                                   if (nullWindowEval != initialAlpha) {
                                       // this move is better than the current option
-                                      boardCopy->makeMoveWithoutGeneratingMoves(moveCopy);
-                                      auto fullWindowEval = getEvaluation(boardCopy, depth, alpha, beta,
-                                                                          generator->pvsStrategy);
-                                      strategy->updateEvaluation(fullWindowEval, shouldExit, alpha, beta);
-                                      boardCopy->unmakeMove(moveCopy);
+                                      searchMove(&boardCopy, moveCopy, depth, sharedAlpha, beta, context, generator->pvsStrategy);
                                   }
-
-                                  if (shouldExit || generator->parent->analysisFinished) return;
                               }
-                          });
+                          }, context);
 
-        return alpha;
+        bestMove = sharedAlpha.getMove();
+        return sharedAlpha.getValue();
     }
 
     const Base *ParallelPvs::getFirstMoveEvaluationStrategy() const {
         return generator->pvsStrategy;
     }
-}
\ No newline at end of file
+}
@@ -3,27 +3,30 @@
 #include "ai/move_generator.h"
 
 namespace DeepEvaluationStrategy {
-    int64_t Pvs::_deepEvaluate(Board *board, std::vector<MoveVariant> moves, int depth, int64_t alpha, int64_t beta) const {
+    int64_t Pvs::_deepEvaluate(Board *board, MovePicker &picker, int depth, int64_t alpha, int64_t beta, Move &bestMove) const {
         bool shouldExit = false;
 
-        board->makeMoveWithoutGeneratingMoves(moves[0]);
+        auto firstMove = picker.next();
+        makeMove(board, firstMove);
         alpha = getEvaluation(board, depth, alpha, beta, generator->pvsStrategy);
-        board->unmakeMove(moves[0]);
+        board->unmakeMove(firstMove);
+        bestMove = firstMove;
 
-        for (size_t i = 1; i < moves.size(); i++) {
-            board->makeMoveWithoutGeneratingMoves(moves[i]);
+        for (auto move = picker.next(); !move.isNull(); move = picker.next()) {
+            makeMove(board, move);
             auto nullWindowEval = getNullWindowEval(board, depth, alpha);
-            board->unmakeMove(moves[i]);
+            board->unmakeMove(move);
 
             if (nullWindowEval != alpha) {
                 // this move is better than the current option
-                board->makeMoveWithoutGeneratingMoves(moves[i]);
+                makeMove(board, move);
                 auto fullWindowEval = getEvaluation(board, depth, alpha, beta, generator->pvsStrategy);
-                strategy->updateEvaluation(fullWindowEval, shouldExit, alpha, beta);
-                board->unmakeMove(moves[i]);
+                strategy->updateEvaluation(fullWindowEval, move, shouldExit, alpha, beta, bestMove);
+                board->unmakeMove(move);
+                if (shouldExit) recordCutoff(move, depth);
             }
 
-            if (shouldExit || generator->parent->analysisFinished) return alpha;
+            if (shouldExit || shouldStop()) return alpha;
         }
 
         return alpha;
@@ -9,6 +9,6 @@ namespace DeepEvaluationStrategy {
     public:
         explicit Pvs(SingleDepthMoveGenerator *generator): Sequential(generator) {}
     protected:
-        int64_t _deepEvaluate(Board *board, std::vector<MoveVariant> moves, int depth, int64_t alpha, int64_t beta) const override;
+        int64_t _deepEvaluate(Board *board, MovePicker &picker, int depth, int64_t alpha, int64_t beta, Move &bestMove) const override;
     };
 }
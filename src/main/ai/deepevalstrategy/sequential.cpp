@@ -3,12 +3,12 @@
 #include "ai/move_generator.h"
 
 namespace DeepEvaluationStrategy {
-    int64_t Sequential::_deepEvaluate(Board *board, std::vector<MoveVariant> moves, int depth, int64_t alpha, int64_t beta) const {
+    int64_t Sequential::_deepEvaluate(Board *board, MovePicker &picker, int depth, int64_t alpha, int64_t beta, Move &bestMove) const {
         bool shouldExit = false;
 
-        for (auto &move: moves) {
-            if (shouldExit || generator->parent->analysisFinished) return alpha;
-            deepEvaluateMove(board, move, depth, alpha, beta, shouldExit, strategy);
+        for (auto move = picker.next(); !move.isNull(); move = picker.next()) {
+            if (shouldExit || shouldStop()) return alpha;
+            deepEvaluateMove(board, move, depth, alpha, beta, shouldExit, bestMove, strategy, generator->sequentialStrategy);
         }
 
         return alpha;
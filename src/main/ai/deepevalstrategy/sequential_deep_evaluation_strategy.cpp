@@ -10,13 +10,13 @@ int64_t SequentialDeepEvaluationStrategy::deepEvaluate(Board *board, int depth)
         return searchCaptures(board, EvalValues::min, EvalValues::max);
     }
 
-    board->generateMoves();
+    MoveList moves;
+    board->generateMoves(moves);
 
-    if (board->legalMoves.empty()) {
+    if (moves.empty()) {
         return evaluatePositionWithoutMoves(board, depth);
     }
 
-    auto moves = std::vector(board->legalMoves);
     sortMoves(board, moves);
 
     int64_t alpha = EvalValues::min;
@@ -63,13 +63,13 @@ int64_t SequentialDeepEvaluationStrategy::alphaBeta(Board *board, int depth, int
         return searchCaptures(board, alpha, beta);
     }
 
-    board->generateMoves();
+    MoveList moves;
+    board->generateMoves(moves);
 
-    if (board->legalMoves.empty()) {
+    if (moves.empty()) {
         return evaluatePositionWithoutMoves(board, depth);
     }
 
-    auto moves = std::vector(board->legalMoves);
     sortMoves(board, moves);
 
     for (auto move: moves) {
@@ -116,13 +116,13 @@ int64_t SequentialDeepEvaluationStrategy::pureAlphaBeta(Board *board, int depth,
         return searchCaptures(board, alpha, beta);
     }
 
-    board->generateMoves();
+    MoveList moves;
+    board->generateMoves(moves);
 
-    if (board->legalMoves.empty()) {
+    if (moves.empty()) {
         return evaluatePositionWithoutMoves(board, depth);
     }
 
-    auto moves = std::vector(board->legalMoves);
     sortMoves(board, moves);
 
     for (auto move: moves) {
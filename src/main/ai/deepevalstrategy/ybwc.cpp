@@ -0,0 +1,73 @@
+#include "ybwc.h"
+#include <algorithm>
+#include <mutex>
+#include <tbb/task_group.h>
+#include "ai/shared_bound.h"
+#include "ai/single_depth_move_generator.h"
+
+namespace DeepEvaluationStrategy {
+    int64_t Ybwc::_deepEvaluate(Board *board, MovePicker &picker, int depth, int64_t alpha, int64_t beta, Move &bestMove) const {
+        auto firstMove = picker.next();
+        makeMove(board, firstMove);
+        auto firstMoveEval = getEvaluation(board, depth, alpha, beta, generator->ybwcStrategy);
+        board->unmakeMove(firstMove);
+        bestMove = firstMove;
+
+        if (firstMoveEval >= beta) {
+            recordCutoff(firstMove, depth);
+            return beta;
+        }
+
+        SharedBound sharedAlpha(std::max(alpha, firstMoveEval), firstMove);
+        std::mutex pickerMutex;
+        tbb::task_group group;
+
+        auto searchSiblings = [&]() {
+            UndoBuffer undoBuffer;
+            Board boardCopy(*board, undoBuffer);
+
+            while (sharedAlpha.getValue() < beta && !shouldStop()) {
+                Move move;
+                {
+                    std::lock_guard lock(pickerMutex);
+                    move = picker.next();
+                }
+                if (move.isNull()) return;
+
+                auto currentAlpha = sharedAlpha.getValue();
+                makeMove(&boardCopy, move);
+                auto evaluation = getEvaluation(&boardCopy, depth, currentAlpha, currentAlpha + 1, generator->ybwcStrategy);
+
+                if (evaluation > currentAlpha && evaluation < beta) {
+                    // this move is better than the current option
+                    currentAlpha = sharedAlpha.getValue();
+                    evaluation = getEvaluation(&boardCopy, depth, currentAlpha, beta, generator->ybwcStrategy);
+                }
+
+                boardCopy.unmakeMove(move);
+
+                if (shouldStop()) return;
+
+                if (evaluation >= beta) {
+                    sharedAlpha.raise(beta, move);
+                    group.cancel();
+                    recordCutoff(move, depth);
+                    return;
+                }
+
+                sharedAlpha.raise(evaluation, move);
+            }
+        };
+
+        if (depth >= minSplitDepth) {
+            for (int i = 1; i < generator->threadCount; i++)
+                group.run(searchSiblings);
+        }
+
+        // the calling thread works on the split point too, inside the group so that a cutoff stops it as well
+        group.run_and_wait(searchSiblings);
+
+        bestMove = sharedAlpha.getMove();
+        return sharedAlpha.getValue();
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "base.h"
+
+class SingleDepthMoveGenerator;
+
+namespace DeepEvaluationStrategy {
+    // Young Brothers Wait: the other moves are only split between the threads once the first is searched
+    class Ybwc : public Base {
+    public:
+        explicit Ybwc(SingleDepthMoveGenerator *generator) : Base(generator) {}
+
+        // below this depth the moves are searched by one thread, as splitting costs more than it saves
+        static const int minSplitDepth = 3;
+
+    private:
+        int64_t _deepEvaluate(Board *board, MovePicker &picker, int depth, int64_t alpha, int64_t beta, Move &bestMove) const override;
+    };
+}
@@ -1,23 +1,19 @@
 #include "evaluation_update_strategy.h"
 #include "transposition.h"
 
-void EvaluationUpdateStrategy::_updateEvaluation(int64_t evaluation, bool &shouldExit, int64_t &alpha, int64_t &beta) {
+void EvaluationUpdateStrategy::_updateEvaluation(int64_t evaluation, Move move, bool &shouldExit, int64_t &alpha, int64_t &beta, Move &bestMove) {
     if (evaluation >= beta) {
         shouldExit = true;
         alpha = beta;
+        bestMove = move;
         return;
     }
     if (evaluation > alpha) {
         alpha = evaluation;
+        bestMove = move;
     }
 }
 
-void ParallelizedUpdateStrategy::updateEvaluation(int64_t evaluation, bool &shouldExit, int64_t &alpha, int64_t &beta) {
-    mutex.lock();
-    _updateEvaluation(evaluation, shouldExit, alpha, beta);
-    mutex.unlock();
-}
-
-void NonParallelizedUpdateStrategy::updateEvaluation(int64_t evaluation, bool &shouldExit, int64_t &alpha, int64_t &beta) {
-    _updateEvaluation(evaluation, shouldExit, alpha, beta);
+void NonParallelizedUpdateStrategy::updateEvaluation(int64_t evaluation, Move move, bool &shouldExit, int64_t &alpha, int64_t &beta, Move &bestMove) {
+    _updateEvaluation(evaluation, move, shouldExit, alpha, beta, bestMove);
 }
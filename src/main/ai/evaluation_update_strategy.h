@@ -1,24 +1,17 @@
 #pragma once
 
 #include <cstdint>
-#include <mutex>
+#include "../move/move.h"
 
 class EvaluationUpdateStrategy {
 public:
-    virtual void updateEvaluation(int64_t evaluation, bool &shouldExit, int64_t &alpha, int64_t &beta) = 0;
+    virtual void updateEvaluation(int64_t evaluation, Move move, bool &shouldExit, int64_t &alpha, int64_t &beta, Move &bestMove) = 0;
 
 protected:
-    static void _updateEvaluation(int64_t evaluation, bool &shouldExit, int64_t &alpha, int64_t &beta);
-};
-
-class ParallelizedUpdateStrategy : public EvaluationUpdateStrategy {
-    std::mutex mutex = std::mutex();
-
-public:
-    void updateEvaluation(int64_t evaluation, bool &shouldExit, int64_t &alpha, int64_t &beta) override;
+    static void _updateEvaluation(int64_t evaluation, Move move, bool &shouldExit, int64_t &alpha, int64_t &beta, Move &bestMove);
 };
 
 class NonParallelizedUpdateStrategy : public EvaluationUpdateStrategy {
 public:
-    void updateEvaluation(int64_t evaluation, bool &shouldExit, int64_t &alpha, int64_t &beta) override;
+    void updateEvaluation(int64_t evaluation, Move move, bool &shouldExit, int64_t &alpha, int64_t &beta, Move &bestMove) override;
 };
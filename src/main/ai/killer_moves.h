@@ -0,0 +1,27 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "../move/move.h"
+
+// quiet moves that caused a cutoff at each depth, where a lost update only costs move ordering
+class KillerMoves {
+public:
+    static const int maxDepth = 64;
+
+    Move get(int depth, int slot) const {
+        if (depth >= maxDepth) return {};
+        return Move::fromData(moves[depth][slot].load(std::memory_order_relaxed));
+    }
+
+    void store(int depth, Move move) {
+        if (depth >= maxDepth || move.isCapture() || get(depth, 0) == move) return;
+
+        moves[depth][1].store(moves[depth][0].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        moves[depth][0].store(move.getData(), std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::array<std::atomic<uint16_t>, 2>, maxDepth> moves{};
+};
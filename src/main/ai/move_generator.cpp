@@ -6,34 +6,78 @@
 #include "move_generator.h"
 #include "../util/vector_util.h"
 #include "single_depth_move_generator.h"
+#include "deepevalstrategy/lazy_smp.h"
+#include <tbb/task_arena.h>
 
-Move *MoveGenerator::getBestMove(Board *board, AiSettings settings) {
-    using namespace std::chrono;
+// the search thread deepens until the time manager stops it, and is cancelled at the hard limit
+Move MoveGenerator::getBestMove(Board *board, AiSettings settings, TimeControl timeControl) {
+    // the previous search was cancelled when it returned, so its thread is about to finish
+    if (thread) thread->join();
+    delete thread;
 
-    thread = new std::thread([board, settings, this]() {
+    cancellation.reset();
+    begin = steady_clock::now();
+    positionsAnalyzed = 0;
+    bestMove = {};
+    isSearchFinished = false;
+
+    TimeManager timeManager(timeControl);
+    auto hardLimit = milliseconds(timeManager.getHardLimit());
+
+    // a table of its own follows the settings, a shared one is sized by its owner
+    if (ownsTranspositions && transpositions->getSize() != settings.transpositionTableSize)
+        transpositions->resize(settings.transpositionTableSize);
+
+    transpositions->newSearch();
+
+    thread = new std::thread([board, settings, timeManager, this]() mutable {
+        tbb::task_arena arena(settings.getThreadCount());
+        auto lazySmp = settings.searchStrategy == SearchStrategy::LazySmp
+                       ? new LazySmp(this, board, settings.getThreadCount() - 1) : nullptr;
         int depth = 1;
 
-        while (!analysisFinished) {
+        while (!cancellation.isCancelled()) {
             Board *boardCopy = board->copy();
-            auto generator = new SingleDepthMoveGenerator(this, boardCopy, depth);
-            auto supposedBestMove = generator->getBestMove(bestMove, settings);
+            boardCopy->generateMoves();
+            auto generator = new SingleDepthMoveGenerator(this, boardCopy, depth, settings.getThreadCount());
+            Move supposedBestMove;
+            arena.execute([&] { supposedBestMove = generator->getBestMove(bestMove, settings); });
+            auto score = generator->alpha.getValue();
             delete generator;
             delete boardCopy;
-            if (analysisFinished) break;
-            bestMove = supposedBestMove;
-            auto millisCount = duration_cast<milliseconds>(steady_clock::now() - begin).count();
-            analysisInfo = new AnalysisInfo{positionsAnalyzed, depth + 1, bestMove, millisCount};
+            if (cancellation.isCancelled()) break;
+
+            auto millisCount = getMillisElapsed();
+            timeManager.onIterationFinished(supposedBestMove, score, millisCount);
+            bool shouldFinish = supposedBestMove.isNull() || !timeManager.shouldStartNextIteration(millisCount);
+
+            {
+                std::lock_guard lock(mutex);
+                bestMove = supposedBestMove;
+                analysisInfo = new AnalysisInfo{positionsAnalyzed.load(), depth + 1, bestMove, millisCount};
+                isSearchFinished = shouldFinish;
+            }
+            iterationFinished.notify_one();
+
+            if (shouldFinish) break;
             depth++;
         }
-    });
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+        // the helpers only stop once the search is cancelled
+        cancellation.cancel();
+        delete lazySmp;
+    });
 
-    while (!bestMove) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
-    }
+    std::unique_lock lock(mutex);
+    iterationFinished.wait_until(lock, begin + hardLimit, [this] { return isSearchFinished; });
+    // a move is needed even when the first iteration takes longer than the whole limit
+    iterationFinished.wait(lock, [this] { return isSearchFinished || !bestMove.isNull(); });
 
-    analysisFinished = true;
+    cancellation.cancel();
 
     return bestMove;
 }
+
+long MoveGenerator::getMillisElapsed() const {
+    return duration_cast<milliseconds>(steady_clock::now() - begin).count();
+}
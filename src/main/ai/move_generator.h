@@ -4,6 +4,12 @@
 #include "ai_settings.h"
 #include "deepevalstrategy/base.h"
 #include "constants.h"
+#include "transposition_table.h"
+#include "cancellation_token.h"
+#include "time_manager.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
 using namespace DeepEvaluationStrategy;
@@ -11,20 +17,37 @@ using namespace std::chrono;
 
 class MoveGenerator {
 public:
-    unsigned long positionsAnalyzed = 0;
+    // written by every search thread, so kept off the cache line of anything they read
+    alignas(64) std::atomic<unsigned long> positionsAnalyzed = 0;
     AnalysisInfo *analysisInfo = nullptr;
-    bool analysisFinished = false;
+    CancellationToken cancellation;
+    TranspositionTable *transpositions;
 
-    Move *getBestMove(Board *board, AiSettings settings = prodAiSettings);
+    // pass the engine's table to keep what earlier moves found, otherwise the generator uses its own
+    explicit MoveGenerator(TranspositionTable *transpositions = nullptr)
+            : transpositions(transpositions ? transpositions : new TranspositionTable()),
+              ownsTranspositions(!transpositions) {}
+
+    // searches for as long as the time manager gives it, a full second unless a clock is passed
+    Move getBestMove(Board *board, AiSettings settings = prodAiSettings,
+                     TimeControl timeControl = TimeControl::perMove(1000));
     static long evaluate(Board *board, int depth);
 
     ~MoveGenerator() {
-        thread->join();
+        if (thread) thread->join();
 
         delete thread;
+        if (ownsTranspositions) delete transpositions;
     }
 private:
-    steady_clock::time_point begin = steady_clock::now();
+    bool ownsTranspositions;
+    steady_clock::time_point begin;
     std::thread *thread = nullptr;
-    Move *bestMove = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable iterationFinished;
+    Move bestMove;
+    bool isSearchFinished = false;
+
+    long getMillisElapsed() const;
 };
\ No newline at end of file
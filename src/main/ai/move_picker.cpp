@@ -0,0 +1,104 @@
+#include <utility>
+#include "move_picker.h"
+#include "move_sorting.h"
+
+MovePicker::MovePicker(Board *board, Move hashMove, Move firstKiller, Move secondKiller)
+        : board(board), hashMove(hashMove), killers{firstKiller, secondKiller} {}
+
+Move MovePicker::next() {
+    if (!pendingMove.isNull()) return std::exchange(pendingMove, Move());
+    return pickNext();
+}
+
+bool MovePicker::hasMoves() {
+    if (pendingMove.isNull()) pendingMove = pickNext();
+    return !pendingMove.isNull();
+}
+
+void MovePicker::collectRemaining(MoveList &remaining) {
+    for (auto move = next(); !move.isNull(); move = next())
+        remaining.push(move);
+}
+
+static bool isGoodCapture(const Board *board, Move move) {
+    auto movedPiece = board->squares[move.getStartSquare()];
+    auto capturedPiece = board->squares[move.getCapturedSquare()];
+    return move.isPromotion() || Piece::getValue(capturedPiece) >= Piece::getValue(movedPiece);
+}
+
+Move MovePicker::pickNext() {
+    switch (stage) {
+        case Stage::HashMove:
+            stage = Stage::GenerateCaptures;
+            if (board->isLegal(hashMove)) return hashMove;
+            [[fallthrough]];
+
+        case Stage::GenerateCaptures:
+            board->generateCaptures(moves, true);
+            for (auto &move: moves) move.score = guessMoveValue(board, move);
+            index = 0;
+            stage = Stage::GoodCaptures;
+            [[fallthrough]];
+
+        case Stage::GoodCaptures:
+            while (index < moves.size()) {
+                auto move = pickBest();
+                if (isAlreadyPicked(move) || !board->isPseudoLegalMoveLegal(move)) continue;
+                if (isGoodCapture(board, move)) return move;
+                badCaptures.push(move);
+            }
+            stage = Stage::FirstKiller;
+            [[fallthrough]];
+
+        case Stage::FirstKiller:
+            stage = Stage::SecondKiller;
+            if (killers[0] != hashMove && board->isLegal(killers[0])) return killers[0];
+            [[fallthrough]];
+
+        case Stage::SecondKiller:
+            stage = Stage::GenerateQuietMoves;
+            if (killers[1] != hashMove && killers[1] != killers[0] && board->isLegal(killers[1]))
+                return killers[1];
+            [[fallthrough]];
+
+        case Stage::GenerateQuietMoves:
+            board->generateQuietMoves(moves, true);
+            for (auto &move: moves) move.score = guessMoveValue(board, move);
+            index = 0;
+            stage = Stage::QuietMoves;
+            [[fallthrough]];
+
+        case Stage::QuietMoves:
+            while (index < moves.size()) {
+                auto move = pickBest();
+                if (!isAlreadyPicked(move) && board->isPseudoLegalMoveLegal(move)) return move;
+            }
+            stage = Stage::BadCaptures;
+            [[fallthrough]];
+
+        case Stage::BadCaptures:
+            if (badCaptureIndex < badCaptures.size()) return badCaptures[badCaptureIndex++];
+            stage = Stage::Done;
+            [[fallthrough]];
+
+        case Stage::Done:
+            return {};
+    }
+
+    return {};
+}
+
+// selection sort one step at a time, as most nodes only ever look at the first few moves
+Move MovePicker::pickBest() {
+    auto best = index;
+
+    for (auto i = index + 1; i < moves.size(); i++)
+        if (moves[i].score > moves[best].score) best = i;
+
+    std::swap(moves[index], moves[best]);
+    return moves[index++];
+}
+
+bool MovePicker::isAlreadyPicked(Move move) const {
+    return move == hashMove || move == killers[0] || move == killers[1];
+}
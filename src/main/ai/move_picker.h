@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../board/board.h"
+#include "../move/move_list.h"
+
+// hands out the moves best guess first, in stages, so that the stages after a cutoff are never generated
+class MovePicker {
+public:
+    explicit MovePicker(Board *board, Move hashMove = {}, Move firstKiller = {}, Move secondKiller = {});
+
+    Move next();
+    bool hasMoves();
+
+    void collectRemaining(MoveList &moves);
+
+private:
+    enum class Stage {
+        HashMove, GenerateCaptures, GoodCaptures, FirstKiller, SecondKiller,
+        GenerateQuietMoves, QuietMoves, BadCaptures, Done
+    };
+
+    Board *board;
+    Stage stage = Stage::HashMove;
+    Move hashMove;
+    Move killers[2];
+    Move pendingMove;
+
+    MoveList moves;
+    size_t index = 0;
+    MoveList badCaptures;
+    size_t badCaptureIndex = 0;
+
+    Move pickNext();
+    Move pickBest();
+    bool isAlreadyPicked(Move move) const;
+};
@@ -2,4 +2,5 @@
 
 #include "../board/board.h"
 
-void sortMoves(Board *board, std::vector<MoveVariant> &moves);
+int64_t guessMoveValue(const Board *board, Move move);
+void sortMoves(Board *board, MoveList &moves);
@@ -9,8 +9,8 @@ int64_t searchCaptures(Board *board, long alpha, long beta) {
 
     alpha = std::max(alpha, evaluation);
 
-    board->generateCaptures();
-    auto moves = std::vector(board->legalMoves);
+    MoveList moves;
+    board->generateCaptures(moves);
     sortMoves(board, moves);
 
     for (auto move: moves) {
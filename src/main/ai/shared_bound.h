@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "compressed_eval.h"
+#include "../move/move.h"
+
+// the alpha of a node searched by several threads and the move that set it, in one atomic word
+class SharedBound {
+public:
+    explicit SharedBound(Eval value, Move move = {}) : data(pack(value, move)) {}
+
+    // returns whether the move set the bound
+    bool raise(Eval value, Move move) {
+        auto current = data.load(std::memory_order_relaxed);
+        auto raised = pack(value, move);
+
+        while (getValue(current) < value) {
+            if (data.compare_exchange_weak(current, raised, std::memory_order_relaxed)) return true;
+        }
+
+        return false;
+    }
+
+    Eval getValue() const { return getValue(data.load(std::memory_order_relaxed)); }
+    Move getMove() const { return Move::fromData((uint16_t) data.load(std::memory_order_relaxed)); }
+
+private:
+    std::atomic<int64_t> data;
+
+    static int64_t pack(Eval value, Move move) {
+        return (int64_t) CompressedEval::compress(value) << 32 | move.getData();
+    }
+
+    static Eval getValue(int64_t data) {
+        return CompressedEval::decompress((int32_t) (data >> 32));
+    }
+};
@@ -1,60 +1,81 @@
 #include "single_depth_move_generator.h"
-#include "util/thread_util.h"
-#include "util/vector_util.h"
 #include "ai/move_generator.h"
 #include "ai/move_sorting.h"
 #include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
+
+SingleDepthMoveGenerator::SingleDepthMoveGenerator(MoveGenerator *parent, Board *board, const int depth,
+                                                   const int threadCount)
+        : transpositions(parent->transpositions), parent(parent), board(board), depth(depth),
+          threadCount(threadCount) {}
+
+Move SingleDepthMoveGenerator::getBestMove(Move supposedBestMove, AiSettings settings) {
+    if (board->legalMoves.empty()) return {};
+
+    switch (settings.searchStrategy) {
+        // the Lazy SMP helpers are run by the parent, alongside every depth
+        case SearchStrategy::LazySmp: return getBestMoveFromRootSearch(pvsStrategy);
+        case SearchStrategy::Ybwc: return getBestMoveFromRootSearch(ybwcStrategy);
+        case SearchStrategy::Abdada: return getBestMoveFromRootSearch(abdadaStrategy);
+        case SearchStrategy::RootSplit: break;
+    }
 
-Move *SingleDepthMoveGenerator::getBestMove(Move *supposedBestMove, AiSettings settings) {
-    if (board->legalMoves.empty()) return nullptr;
-
-    auto moves = getSortedMoves(supposedBestMove);
+    MoveList moves;
+    getSortedMoves(moves, supposedBestMove);
 
-    alpha = evalFirstMove(moves);
-    bestMove = moves[0];
+    // run in the token's context like the other moves, so that cancelling reaches its nested loops
+    tbb::task_group firstMoveGroup(parent->cancellation.getContext());
+    firstMoveGroup.run_and_wait([&moves, this] { alpha.raise(evalFirstMove(moves), moves[0]); });
 
-    tbb::parallel_for(tbb::blocked_range<size_t>(1, moves.size()), [moves, this](tbb::blocked_range<size_t> range) {
-        Board *boardCopy = this->board->copy();
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, moves.size()), [&moves, this](tbb::blocked_range<size_t> range) {
+        UndoBuffer undoBuffer;
+        Board boardCopy(*this->board, undoBuffer);
 
         for (size_t i = range.begin(); i < range.end(); i++) {
-            doFullEvalIfNeeded(boardCopy, moves[i]);
-            if (parent->analysisFinished) break;
+            doFullEvalIfNeeded(&boardCopy, moves[i]);
+            if (shouldStop()) break;
         }
+    }, parent->cancellation.getContext());
+
+    // null only when the search was cancelled before the first move finished
+    auto bestMove = alpha.getMove();
+    return bestMove.isNull() ? moves[0] : bestMove;
+}
 
-        delete boardCopy;
-    });
+Move SingleDepthMoveGenerator::getBestMoveFromRootSearch(const Base *strategy) {
+    auto evaluation = strategy->deepEvaluate(board, depth + 1);
 
-    deleteInTheBackground(transpositions);
+    Transposition transposition;
+    auto bestMove = board->legalMoves[0];
+    if (transpositions->probe(board->getZobristHash(), transposition) && board->isLegal(transposition.bestMove))
+        bestMove = transposition.bestMove;
 
-    return visit(GetMovePointerVisitor, bestMove.value());
+    alpha.raise(evaluation, bestMove);
+    return bestMove;
 }
 
-void SingleDepthMoveGenerator::evalMove(MoveVariant move) {
-    auto boardCopy = board->copy();
-    boardCopy->makeMoveWithoutGeneratingMoves(move);
-    auto eval = -parallelPvsStrategy->deepEvaluate(boardCopy, depth, EvalValues::min, -alpha);
-    boardCopy->unmakeMove(move);
+// the TBB check catches searches running in a task group cancelled after a cutoff
+bool SingleDepthMoveGenerator::shouldStop() const {
+    return parent->cancellation.isCancelled() || isStopped || tbb::is_current_task_group_canceling();
+}
 
-    mutex.lock();
-    if (eval > alpha) {
-        alpha = eval;
-        bestMove = move;
-    }
-    mutex.unlock();
+void SingleDepthMoveGenerator::evalMove(Move move) {
+    UndoBuffer undoBuffer;
+    Board boardCopy(*board, undoBuffer);
+    boardCopy.makeMoveWithoutGeneratingMoves(move);
+    auto eval = -parallelPvsStrategy->deepEvaluate(&boardCopy, depth, EvalValues::min, -alpha.getValue());
+    boardCopy.unmakeMove(move);
 
-    delete boardCopy;
+    alpha.raise(eval, move);
 }
 
-std::vector<MoveVariant> SingleDepthMoveGenerator::getSortedMoves(Move *supposedBestMove) const {
-    auto moves = board->legalMoves;
-    if (!supposedBestMove) {
+void SingleDepthMoveGenerator::getSortedMoves(MoveList &moves, Move supposedBestMove) const {
+    moves = board->legalMoves;
+    if (supposedBestMove.isNull()) {
         sortMoves(board, moves);
     } else {
-        auto supposedBestMoveIndex = VectorUtil::indexOf(moves, supposedBestMove->toVariant());
-        VectorUtil::move(moves, supposedBestMoveIndex, 0);
+        moves.moveToFront(supposedBestMove);
     }
-
-    return moves;
 }
 
 int64_t SingleDepthMoveGenerator::deepEval(Board *board, int64_t lowerBound, int64_t upperBound) const {
@@ -65,8 +86,8 @@ int64_t SingleDepthMoveGenerator::nullWindowEval(Board *board, int64_t lowerBoun
     return deepEval(board, lowerBound, lowerBound + 1);
 }
 
-bool SingleDepthMoveGenerator::needsFullEval(Board *board, MoveVariant &move) const {
-    auto initialAlpha = this->alpha;
+bool SingleDepthMoveGenerator::needsFullEval(Board *board, Move move) const {
+    auto initialAlpha = alpha.getValue();
     board->makeMoveWithoutGeneratingMoves(move);
     auto eval = nullWindowEval(board, initialAlpha);
     board->unmakeMove(move);
@@ -74,13 +95,13 @@ bool SingleDepthMoveGenerator::needsFullEval(Board *board, MoveVariant &move) co
     return eval != initialAlpha;
 }
 
-void SingleDepthMoveGenerator::doFullEvalIfNeeded(Board *board, MoveVariant move) {
+void SingleDepthMoveGenerator::doFullEvalIfNeeded(Board *board, Move move) {
     if (needsFullEval(board, move)) {
         evalMove(move);
     }
 }
 
-int64_t SingleDepthMoveGenerator::evalFirstMove(std::vector<MoveVariant> moves) const {
+int64_t SingleDepthMoveGenerator::evalFirstMove(const MoveList &moves) const {
     board->makeMoveWithoutGeneratingMoves(moves[0]);
     int64_t firstMoveAlpha = -parallelPvsStrategy->deepEvaluate(board, depth, EvalValues::min, EvalValues::max);
     board->unmakeMove(moves[0]);
@@ -1,7 +1,9 @@
 #pragma once
 
-#include <mutex>
+#include <atomic>
 #include "ai/transposition_table.h"
+#include "ai/killer_moves.h"
+#include "ai/shared_bound.h"
 #include "move/move.h"
 #include "ai/ai_settings.h"
 #include "ai/constants.h"
@@ -11,6 +13,8 @@
 #include "ai/deepevalstrategy/pvs.h"
 #include "ai/deepevalstrategy/parallel_pvs.h"
 #include "ai/deepevalstrategy/parallel_pvs_with_sequential_children.h"
+#include "ai/deepevalstrategy/ybwc.h"
+#include "ai/deepevalstrategy/abdada.h"
 
 class MoveGenerator;
 
@@ -18,31 +22,39 @@ using namespace DeepEvaluationStrategy;
 
 class SingleDepthMoveGenerator {
 public:
-    explicit SingleDepthMoveGenerator(MoveGenerator *parent, Board *board, const int depth) : parent(parent), board(board), depth(depth) {}
+    explicit SingleDepthMoveGenerator(MoveGenerator *parent, Board *board, const int depth,
+                                      const int threadCount = prodAiSettings.getThreadCount());
 
-    TranspositionTable *transpositions = new TranspositionTable();
+    TranspositionTable *transpositions;
+    KillerMoves killerMoves;
     MoveGenerator *parent;
     Board *board;
     const int depth;
-    std::optional<MoveVariant> bestMove;
-    int64_t alpha = EvalValues::min;
-    std::mutex mutex;
+    const int threadCount;
+    SharedBound alpha{EvalValues::min};
+    // set on the generators of ABDADA helpers once the main search no longer needs them
+    std::atomic<bool> isStopped = false;
 
     const Sequential * const sequentialStrategy = new Sequential(this);
     const Parallel * const parallelStrategy = new Parallel(this);
     const Pvs * const pvsStrategy = new Pvs(this);
     const ParallelPvs * const parallelPvsStrategy = new ParallelPvs(this);
     const ParallelPvsWithSequentialChildren * const parallelPvsWithSequentialChildrenStrategy = new ParallelPvsWithSequentialChildren(this);
+    const Ybwc * const ybwcStrategy = new Ybwc(this);
+    const Abdada * const abdadaStrategy = new Abdada(this);
+    const Abdada * const abdadaSearchStrategy = new Abdada(this, false);
 
-    Move *getBestMove(Move *supposedBestMove, AiSettings settings);
-    int64_t evalFirstMove(std::vector<MoveVariant> moves) const;
+    Move getBestMove(Move supposedBestMove, AiSettings settings);
+    Move getBestMoveFromRootSearch(const Base *strategy);
+    bool shouldStop() const;
+    int64_t evalFirstMove(const MoveList &moves) const;
     int64_t deepEval(Board *board, int64_t lowerBound, int64_t upperBound) const;
     int64_t nullWindowEval(Board *board, int64_t lowerBound) const;
-    bool needsFullEval(Board *board, MoveVariant &move) const;
+    bool needsFullEval(Board *board, Move move) const;
 
-    void doFullEvalIfNeeded(Board *board, MoveVariant move);
-    void evalMove(MoveVariant move);
-    std::vector<MoveVariant> getSortedMoves(Move *supposedBestMove) const;
+    void doFullEvalIfNeeded(Board *board, Move move);
+    void evalMove(Move move);
+    void getSortedMoves(MoveList &moves, Move supposedBestMove) const;
 
     ~SingleDepthMoveGenerator() {
         delete sequentialStrategy;
@@ -50,5 +62,8 @@ public:
         delete pvsStrategy;
         delete parallelPvsStrategy;
         delete parallelPvsWithSequentialChildrenStrategy;
+        delete ybwcStrategy;
+        delete abdadaStrategy;
+        delete abdadaSearchStrategy;
     }
 };
@@ -0,0 +1,41 @@
+#include <algorithm>
+#include "time_manager.h"
+
+// the hard limit takes at most half of the clock, unless this is the last move of the time control
+TimeManager::TimeManager(TimeControl timeControl) : isFixed(timeControl.isFixed) {
+    if (isFixed) {
+        softLimit = hardLimit = timeControl.remainingMillis;
+        return;
+    }
+
+    auto available = std::max(timeControl.remainingMillis - moveOverhead, 1L);
+    auto movesToGo = timeControl.movesToGo > 0 ? timeControl.movesToGo : defaultMovesToGo;
+    auto share = available / movesToGo + timeControl.incrementMillis * 3 / 4;
+
+    hardLimit = std::min(share * maxHardLimitFactor, movesToGo == 1 ? available : available / 2);
+    softLimit = std::min(share, hardLimit);
+}
+
+void TimeManager::onIterationFinished(Move bestMove, Eval score, long elapsedMillis) {
+    bestMoveChanged = iterationsFinished > 0 && !(bestMove == lastBestMove);
+    scoreDropped = iterationsFinished > 0 && score < lastScore - scoreDropMargin;
+
+    lastIterationMillis = elapsedMillis - lastIterationEnd;
+    lastIterationEnd = elapsedMillis;
+    lastBestMove = bestMove;
+    lastScore = score;
+    iterationsFinished++;
+}
+
+long TimeManager::getExtendedSoftLimit() const {
+    auto limit = softLimit;
+    if (bestMoveChanged) limit += softLimit / 2;
+    if (scoreDropped) limit += softLimit / 2;
+    return std::min(limit, hardLimit);
+}
+
+bool TimeManager::shouldStartNextIteration(long elapsedMillis) const {
+    if (isFixed) return elapsedMillis < hardLimit;
+    if (elapsedMillis >= getExtendedSoftLimit()) return false;
+    return elapsedMillis + lastIterationMillis * expectedIterationGrowth <= hardLimit;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "constants.h"
+#include "../move/move.h"
+#include "../board/piece.h"
+
+struct TimeControl {
+    long remainingMillis;
+    long incrementMillis = 0;
+    // 0 when the remaining time has to last for the rest of the game
+    int movesToGo = 0;
+    // the whole of the remaining time is spent on this move, however the search goes
+    bool isFixed = false;
+
+    static TimeControl perMove(long millis) { return {millis, 0, 1, true}; }
+};
+
+// new iterations are started until the soft limit, and the search is cancelled at the hard one
+class TimeManager {
+public:
+    static const long moveOverhead = 20;
+    static const int defaultMovesToGo = 30;
+    static const int maxHardLimitFactor = 4;
+    static const int expectedIterationGrowth = 2;
+    static const Eval scoreDropMargin = Piece::PawnValue / 4;
+
+    explicit TimeManager(TimeControl timeControl);
+
+    long getSoftLimit() const { return softLimit; }
+    long getHardLimit() const { return hardLimit; }
+
+    void onIterationFinished(Move bestMove, Eval score, long elapsedMillis);
+    bool shouldStartNextIteration(long elapsedMillis) const;
+
+    long getExtendedSoftLimit() const;
+
+private:
+    long softLimit;
+    long hardLimit;
+    bool isFixed;
+
+    long lastIterationEnd = 0;
+    long lastIterationMillis = 0;
+    Move lastBestMove;
+    Eval lastScore = 0;
+    int iterationsFinished = 0;
+    bool bestMoveChanged = false;
+    bool scoreDropped = false;
+};
@@ -1,17 +1,16 @@
 #pragma once
 
 #include <cstdint>
-#include <atomic>
-#include <memory>
+#include "../move/move.h"
 
 struct Transposition {
     int64_t value;
     int depth;
     int type;
+    // the move that raised alpha or caused the cutoff, null when no move did
+    Move bestMove{};
 
-    const static int EXACT = 0;
-    const static int UPPER = 1;
-    const static int LOWER = 2;
+    constexpr static int EXACT = 0;
+    constexpr static int UPPER = 1;
+    constexpr static int LOWER = 2;
 };
-
-typedef std::shared_ptr<std::atomic<Transposition>> AtomicTranspositionPtr;
@@ -1,10 +1,153 @@
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstdlib>
+#include <memory>
+#include <new>
 #include "transposition_table.h"
+#include "compressed_eval.h"
 
-AtomicTranspositionPtr _TranspositionTable::get(int64_t hash) const {
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
 
+static const int generationCount = 64;
+
+// bits 0-31: value, 32-39: depth, 40-41: node type, 42-47: generation, 48-63: best move
+uint64_t TranspositionTable::pack(const Transposition &transposition) const {
+    auto depth = (uint64_t) std::min(transposition.depth, 255);
+
+    return (uint32_t) CompressedEval::compress(transposition.value)
+           | depth << 32
+           | (uint64_t) transposition.type << 40
+           | (uint64_t) generation.load(std::memory_order_relaxed) << 42
+           | (uint64_t) transposition.bestMove.getData() << 48;
+}
+
+Transposition TranspositionTable::unpack(uint64_t data) {
+    return {
+            CompressedEval::decompress((int32_t) (uint32_t) data),
+            (int) (data >> 32 & 0xFF),
+            (int) (data >> 40 & 0b11),
+            Move::fromData(data >> 48),
+    };
+}
+
+// the number of searches since the entry was written, wrapping around after generationCount
+int TranspositionTable::getAge(uint64_t data) const {
+    auto entryGeneration = (int) (data >> 42 & (generationCount - 1));
+    return (generation.load(std::memory_order_relaxed) - entryGeneration) & (generationCount - 1);
+}
+
+// lower is replaced first: empty entries, then old and shallow ones
+int TranspositionTable::getReplacementPriority(uint64_t data) const {
+    if (data == 0) return INT_MIN;
+    return unpack(data).depth - 8 * getAge(data);
+}
+
+TranspositionTable::TranspositionTable(size_t size) {
+    allocate(size);
+}
+
+TranspositionTable::~TranspositionTable() {
+    free();
+}
+
+void TranspositionTable::resize(size_t size) {
+    free();
+    allocate(size);
+}
+
+static const size_t hugePageSize = 2 << 20;
+
+// huge pages, as with 4 KB pages nearly every probe of a large table misses the TLB
+void TranspositionTable::allocate(size_t size) {
+    auto bucketCount = std::bit_floor(std::max<size_t>((size << 20) / sizeof(Bucket), 1));
+    auto bytes = bucketCount * sizeof(Bucket);
+    auto alignment = bytes >= hugePageSize ? hugePageSize : alignof(Bucket);
+
+#if defined(_WIN32)
+    void *memory = _aligned_malloc(bytes, alignment);
+#else
+    void *memory = std::aligned_alloc(alignment, bytes);
+#endif
+    if (!memory) throw std::bad_alloc();
+
+#if defined(MADV_HUGEPAGE)
+    if (alignment == hugePageSize) madvise(memory, bytes, MADV_HUGEPAGE);
+#endif
+
+    this->size = size;
+    buckets = static_cast<Bucket *>(memory);
+    std::uninitialized_value_construct_n(buckets, bucketCount);
+    bucketMask = bucketCount - 1;
+}
+
+void TranspositionTable::free() {
+    if (!buckets) return;
+
+    std::destroy_n(buckets, getBucketCount());
+#if defined(_WIN32)
+    _aligned_free(buckets);
+#else
+    std::free(buckets);
+#endif
+    buckets = nullptr;
+}
+
+bool TranspositionTable::probe(uint64_t hash, Transposition &transposition) const {
+    for (auto &entry: getBucket(hash).entries) {
+        auto data = entry.data.load(std::memory_order_relaxed);
+
+        if ((entry.key.load(std::memory_order_relaxed) ^ data) == hash) {
+            transposition = unpack(data);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// an entry of the current search is only replaced by a deeper one, others by priority
+void TranspositionTable::store(uint64_t hash, Transposition transposition) {
+    auto &entries = getBucket(hash).entries;
+    auto *replaced = &entries[0];
+    int replacedPriority = INT_MAX;
+
+    for (auto &entry: entries) {
+        auto data = entry.data.load(std::memory_order_relaxed);
+
+        if ((entry.key.load(std::memory_order_relaxed) ^ data) == hash) {
+            auto stored = unpack(data);
+            if (getAge(data) == 0 && stored.depth > transposition.depth) return;
+            if (transposition.bestMove.isNull()) transposition.bestMove = stored.bestMove;
+            replaced = &entry;
+            break;
+        }
+
+        auto priority = getReplacementPriority(data);
+
+        if (priority < replacedPriority) {
+            replaced = &entry;
+            replacedPriority = priority;
+        }
+    }
+
+    auto data = pack(transposition);
+    replaced->data.store(data, std::memory_order_relaxed);
+    replaced->key.store(hash ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::newSearch() {
+    generation.store((generation.load(std::memory_order_relaxed) + 1) & (generationCount - 1),
+                     std::memory_order_relaxed);
 }
 
-void _TranspositionTable::insert(uint64_t hash, Transposition transposition) {
-    AtomicTranspositionPtr ptr(new std::atomic<Transposition>(transposition));
-    transpositions.insert({{hash, ptr}});
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < getBucketCount(); i++) {
+        for (auto &entry: buckets[i].entries) {
+            entry.key.store(0, std::memory_order_relaxed);
+            entry.data.store(0, std::memory_order_relaxed);
+        }
+    }
 }
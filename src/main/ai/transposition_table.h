@@ -1,7 +1,90 @@
 #pragma once
 
-#include <tbb/concurrent_hash_map.h>
-#include <vector>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include "transposition.h"
 
-typedef tbb::concurrent_hash_map<uint64_t, AtomicTranspositionPtr> TranspositionTable;
+// lockless: an entry torn by a concurrent write no longer XORs back to its hash and reads as a miss
+class TranspositionTable {
+public:
+    static const size_t defaultSize = 16;
+
+    // in megabytes, rounded down to a power of two buckets
+    explicit TranspositionTable(size_t size = defaultSize);
+    TranspositionTable(const TranspositionTable &other) = delete;
+    TranspositionTable &operator=(const TranspositionTable &other) = delete;
+    ~TranspositionTable();
+
+    // drops every entry, the table must not be in use by a search
+    void resize(size_t size);
+
+    void prefetch(uint64_t hash) const {
+#if defined(__GNUC__)
+        __builtin_prefetch(&getBucket(hash));
+#endif
+    }
+
+    bool probe(uint64_t hash, Transposition &transposition) const;
+    void store(uint64_t hash, Transposition transposition);
+    void clear();
+
+    // call before each search, to age the entries written so far
+    void newSearch();
+
+    size_t getBucketCount() const { return bucketMask + 1; }
+    size_t getSize() const { return size; }
+
+    // positions some thread is searching right now, which Abdada defers
+    void markBeingSearched(uint64_t hash) {
+        getSearchingSlot(hash).store(hash, std::memory_order_relaxed);
+    }
+
+    void unmarkBeingSearched(uint64_t hash) {
+        getSearchingSlot(hash).compare_exchange_strong(hash, 0, std::memory_order_relaxed);
+    }
+
+    bool isBeingSearched(uint64_t hash) const {
+        return getSearchingSlot(hash).load(std::memory_order_relaxed) == hash;
+    }
+
+private:
+    struct Entry {
+        std::atomic<uint64_t> key{0};
+        std::atomic<uint64_t> data{0};
+    };
+
+    static const int entriesPerBucket = 4;
+
+    struct alignas(64) Bucket {
+        std::array<Entry, entriesPerBucket> entries;
+    };
+
+    Bucket *buckets = nullptr;
+    size_t size = 0;
+    uint64_t bucketMask = 0;
+    std::atomic<int> generation = 0;
+
+    static const size_t searchingSlotCount = 1 << 15;
+    std::array<std::atomic<uint64_t>, searchingSlotCount> searchingPositions{};
+
+    const std::atomic<uint64_t> &getSearchingSlot(uint64_t hash) const {
+        return searchingPositions[hash & (searchingSlotCount - 1)];
+    }
+
+    std::atomic<uint64_t> &getSearchingSlot(uint64_t hash) {
+        return searchingPositions[hash & (searchingSlotCount - 1)];
+    }
+
+    const Bucket &getBucket(uint64_t hash) const { return buckets[hash & bucketMask]; }
+    Bucket &getBucket(uint64_t hash) { return buckets[hash & bucketMask]; }
+
+    void allocate(size_t size);
+    void free();
+
+    uint64_t pack(const Transposition &transposition) const;
+    static Transposition unpack(uint64_t data);
+    int getAge(uint64_t data) const;
+    int getReplacementPriority(uint64_t data) const;
+};
@@ -0,0 +1,146 @@
+#include <vector>
+#include "attacks.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define HAS_X86_PEXT
+#endif
+
+namespace Attacks {
+    std::array<SlidingAttackTable, 64> rookTables;
+    std::array<SlidingAttackTable, 64> bishopTables;
+    bool usesPext = false;
+
+    static std::array<Bitboard, 102400> rookAttackStorage;
+    static std::array<Bitboard, 5248> bishopAttackStorage;
+
+#ifdef HAS_X86_PEXT
+    __attribute__((target("bmi2")))
+    unsigned int pextIndex(Bitboard occupied, Bitboard mask) {
+        return _pext_u64(occupied, mask);
+    }
+
+    static bool cpuSupportsPext() {
+        return __builtin_cpu_supports("bmi2");
+    }
+#else
+    unsigned int pextIndex(Bitboard occupied, Bitboard mask) {
+        return 0;
+    }
+
+    static bool cpuSupportsPext() {
+        return false;
+    }
+#endif
+
+    // squares whose occupancy can change the attack set: the rays without the board edges
+    static Bitboard relevantBlockers(int square, bool isRook) {
+        auto &directions = isRook ? rookDirections : bishopDirections;
+        Bitboard mask = 0;
+
+        for (auto &direction: directions) {
+            int file = square % 8 + direction[0];
+            int rank = square / 8 + direction[1];
+
+            while (isOnBoard(file + direction[0], rank + direction[1])) {
+                mask |= BitboardUtil::squareBit(rank * 8 + file);
+                file += direction[0];
+                rank += direction[1];
+            }
+        }
+
+        return mask;
+    }
+
+    class RandomGenerator {
+    public:
+        explicit RandomGenerator(uint64_t seed) : state(seed) {}
+
+        uint64_t next() {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 2685821657736338717ULL;
+        }
+
+        uint64_t nextSparse() {
+            return next() & next() & next();
+        }
+
+    private:
+        uint64_t state;
+    };
+
+    static void findMagic(SlidingAttackTable &table, const std::vector<Bitboard> &occupancies,
+                          const std::vector<Bitboard> &attacks, RandomGenerator &random) {
+        std::vector<int> epoch(occupancies.size(), 0);
+
+        for (int attempt = 1;; attempt++) {
+            table.magic = random.nextSparse();
+            if (BitboardUtil::popCount((table.mask * table.magic) >> 56) < 6) continue;
+
+            bool isValid = true;
+
+            for (size_t i = 0; i < occupancies.size() && isValid; i++) {
+                unsigned int index = (occupancies[i] * table.magic) >> table.shift;
+
+                if (epoch[index] < attempt) {
+                    epoch[index] = attempt;
+                    table.attacks[index] = attacks[i];
+                } else if (table.attacks[index] != attacks[i]) {
+                    isValid = false;
+                }
+            }
+
+            if (isValid) return;
+        }
+    }
+
+    static void initSlidingTables(std::array<SlidingAttackTable, 64> &tables, Bitboard *storage, bool isRook) {
+        RandomGenerator random(isRook ? 728 : 10316);
+        std::vector<Bitboard> occupancies;
+        std::vector<Bitboard> attacks;
+
+        for (int square = 0; square < 64; square++) {
+            auto &table = tables[square];
+            table.mask = relevantBlockers(square, isRook);
+            table.shift = 64 - BitboardUtil::popCount(table.mask);
+            table.attacks = storage;
+
+            occupancies.clear();
+            attacks.clear();
+
+            // enumerate every subset of the mask (Carry-Rippler trick)
+            Bitboard occupied = 0;
+            do {
+                occupancies.push_back(occupied);
+                attacks.push_back(slidingAttacksByRayWalk(square, occupied, isRook));
+                occupied = (occupied - table.mask) & table.mask;
+            } while (occupied);
+
+            if (usesPext) {
+                table.magic = 0;
+                for (size_t i = 0; i < occupancies.size(); i++)
+                    table.attacks[pextIndex(occupancies[i], table.mask)] = attacks[i];
+            } else {
+                findMagic(table, occupancies, attacks, random);
+            }
+
+            storage += occupancies.size();
+        }
+    }
+
+    static void init() {
+#if defined(__BMI2__)
+        usesPext = true;
+#else
+        usesPext = cpuSupportsPext();
+#endif
+        initSlidingTables(rookTables, rookAttackStorage.data(), true);
+        initSlidingTables(bishopTables, bishopAttackStorage.data(), false);
+    }
+
+    static struct AttackTablesInitializer {
+        AttackTablesInitializer() { init(); }
+    } initializer;
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include "bitboard.h"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace Attacks {
+    // only the squares in mask can block the piece, so (occupied & mask) indexes its attacks
+    struct SlidingAttackTable {
+        Bitboard mask;
+        Bitboard magic;
+        unsigned int shift;
+        Bitboard *attacks;
+
+        unsigned int index(Bitboard occupied) const;
+    };
+
+    extern std::array<SlidingAttackTable, 64> rookTables;
+    extern std::array<SlidingAttackTable, 64> bishopTables;
+
+    extern bool usesPext;
+
+    unsigned int pextIndex(Bitboard occupied, Bitboard mask);
+
+    constexpr int rookDirections[4][2]{{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    constexpr int bishopDirections[4][2]{{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    constexpr int knightSteps[8][2]{{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+    constexpr int kingSteps[8][2]{{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+    constexpr int pawnCaptureSteps[2][2][2]{{{-1, 1}, {1, 1}}, {{-1, -1}, {1, -1}}};
+
+    constexpr bool isOnBoard(int file, int rank) {
+        return file >= 0 && file < 8 && rank >= 0 && rank < 8;
+    }
+
+    // slow ray walk used to build the tables, exposed for tests
+    constexpr Bitboard slidingAttacksByRayWalk(int square, Bitboard occupied, bool isRook) {
+        auto &directions = isRook ? rookDirections : bishopDirections;
+        Bitboard attacks = 0;
+
+        for (auto &direction: directions) {
+            int file = square % 8 + direction[0];
+            int rank = square / 8 + direction[1];
+
+            while (isOnBoard(file, rank)) {
+                int targetSquare = rank * 8 + file;
+                attacks |= BitboardUtil::squareBit(targetSquare);
+                if (BitboardUtil::contains(occupied, targetSquare)) break;
+
+                file += direction[0];
+                rank += direction[1];
+            }
+        }
+
+        return attacks;
+    }
+
+    template<int stepCount>
+    constexpr std::array<Bitboard, 64> leaperAttacks(const int (&steps)[stepCount][2]) {
+        std::array<Bitboard, 64> attacks{};
+
+        for (int square = 0; square < 64; square++) {
+            for (auto &step: steps) {
+                int file = square % 8 + step[0];
+                int rank = square / 8 + step[1];
+
+                if (isOnBoard(file, rank))
+                    attacks[square] |= BitboardUtil::squareBit(rank * 8 + file);
+            }
+        }
+
+        return attacks;
+    }
+
+    typedef std::array<std::array<Bitboard, 64>, 64> SquarePairTable;
+
+    // the squares strictly between two aligned squares, or the whole line through them
+    constexpr SquarePairTable squarePairTable(bool wholeLine) {
+        SquarePairTable table{};
+
+        for (int square1 = 0; square1 < 64; square1++) {
+            for (int square2 = 0; square2 < 64; square2++) {
+                if (square1 == square2) continue;
+
+                for (bool isRook: {true, false}) {
+                    if (!BitboardUtil::contains(slidingAttacksByRayWalk(square1, 0, isRook), square2)) continue;
+
+                    auto ends = BitboardUtil::squareBit(square1) | BitboardUtil::squareBit(square2);
+
+                    table[square1][square2] = wholeLine
+                            ? (slidingAttacksByRayWalk(square1, 0, isRook) & slidingAttacksByRayWalk(square2, 0, isRook)) | ends
+                            : slidingAttacksByRayWalk(square1, ends, isRook) & slidingAttacksByRayWalk(square2, ends, isRook);
+                }
+            }
+        }
+
+        return table;
+    }
+
+    inline constexpr std::array<Bitboard, 64> knightAttacks = leaperAttacks(knightSteps);
+    inline constexpr std::array<Bitboard, 64> kingAttacks = leaperAttacks(kingSteps);
+    inline constexpr std::array<std::array<Bitboard, 64>, 2> pawnAttacks{
+        leaperAttacks(pawnCaptureSteps[0]), leaperAttacks(pawnCaptureSteps[1])
+    };
+
+    inline constexpr SquarePairTable betweenSquares = squarePairTable(false);
+    inline constexpr SquarePairTable lineSquares = squarePairTable(true);
+
+    inline unsigned int SlidingAttackTable::index(Bitboard occupied) const {
+#if defined(__BMI2__)
+        return _pext_u64(occupied, mask);
+#else
+        if (usesPext) return pextIndex(occupied, mask);
+        return ((occupied & mask) * magic) >> shift;
+#endif
+    }
+
+    inline Bitboard rook(int square, Bitboard occupied) {
+        auto &table = rookTables[square];
+        return table.attacks[table.index(occupied)];
+    }
+
+    inline Bitboard bishop(int square, Bitboard occupied) {
+        auto &table = bishopTables[square];
+        return table.attacks[table.index(occupied)];
+    }
+
+    inline Bitboard queen(int square, Bitboard occupied) {
+        return rook(square, occupied) | bishop(square, occupied);
+    }
+
+    inline Bitboard king(int square) {
+        return kingAttacks[square];
+    }
+
+    inline Bitboard knight(int square) {
+        return knightAttacks[square];
+    }
+
+    inline Bitboard pawn(int square, int colourIndex) {
+        return pawnAttacks[colourIndex][square];
+    }
+
+    inline Bitboard between(int square1, int square2) {
+        return betweenSquares[square1][square2];
+    }
+
+    inline Bitboard line(int square1, int square2) {
+        return lineSquares[square1][square2];
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <bit>
+
+typedef uint64_t Bitboard;
+
+namespace BitboardUtil {
+    const Bitboard Empty = 0;
+    const Bitboard FileA = 0x0101010101010101;
+    const Bitboard FileH = FileA << 7;
+
+    constexpr Bitboard squareBit(int square) {
+        return Bitboard(1) << square;
+    }
+
+    constexpr bool contains(Bitboard bitboard, int square) {
+        return (bitboard >> square) & 1;
+    }
+
+    constexpr int lsb(Bitboard bitboard) {
+        return std::countr_zero(bitboard);
+    }
+
+    // removes the least significant set bit and returns its index
+    constexpr int popLsb(Bitboard &bitboard) {
+        int square = lsb(bitboard);
+        bitboard &= bitboard - 1;
+        return square;
+    }
+
+    constexpr int popCount(Bitboard bitboard) {
+        return std::popcount(bitboard);
+    }
+}
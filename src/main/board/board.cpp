@@ -1,253 +1,278 @@
 #include <array>
 #include <vector>
-#include <unordered_set>
-#include <unordered_map>
-#include <stack>
+#include <algorithm>
 #include "piece.h"
 #include "../move/move.h"
 #include "board.h"
 #include "board_util.h"
 #include "zobrist_hash_generator.h"
-
-static int getCastlingPiece(int piece, int square) {
-    auto type = Piece::getType(piece);
-    if (type == Piece::King) return piece;
-    if (type != Piece::Rook) return Piece::None;
-
-    int file = square % 8;
-    int colour = Piece::getColour(piece);
-
-    if (!BoardUtil::isRookAtStartRank(square, colour)) return Piece::None;
-
-    if (file == 0) return Piece::LeftRook | colour;
-    if (file == 7) return Piece::RightRook | colour;
-
-    return Piece::None;
-}
-
+#include "attacks.h"
+#include "move_processor.h"
+
+template<int colour>
+struct PawnRanks {
+    static constexpr int forward = colour == Piece::White ? 8 : -8;
+    static constexpr int startRank = colour == Piece::White ? BoardUtil::WhitePawnRank : BoardUtil::BlackPawnRank;
+    // the rank a pawn promotes from, not the one it promotes on
+    static constexpr int promotionRank = colour == Piece::White ? BoardUtil::BlackPawnRank : BoardUtil::WhitePawnRank;
+};
+
+template<class Processor>
 static void generatePawnMove(int startSquare, int targetSquare, bool isPawnAboutToPromote, int pieceToCapture,
-                             MoveProcessor *processor) {
+                             Processor &processor) {
+    bool isCapture = pieceToCapture != Piece::None;
+
     if (!isPawnAboutToPromote) {
-        processor->processMove(NormalMove{startSquare, targetSquare, pieceToCapture});
+        processor.processMove(Move(startSquare, targetSquare, isCapture ? Move::Capture : Move::Normal));
         return;
     }
 
     for (auto piece: Piece::piecesToPromoteTo)
-        processor->processMove(PromotionMove{startSquare, targetSquare, piece, pieceToCapture});
+        processor.processMove(Move::promotion(startSquare, targetSquare, piece, isCapture));
 }
 
 Board *Board::fromFenString(std::string fenString, int colourToMove) {
     auto board = new Board();
     board->colourToMove = colourToMove;
     board->loadFenString(fenString);
+    board->zobristHash = ZobristHashGenerator.hash(board);
     board->generateMoves();
-    board->updateEndgameState();
     return board;
 }
 
 void Board::generateMoves() {
-    legalMoves.clear();
-
-    int colourToMove = this->colourToMove;
-    generateSquaresAttackedByOpponent(Piece::getOpponentColour(colourToMove));
-    isKingUnderAttack = IsKingUnderAttack();
+    generateMoves(legalMoves);
+}
 
-    generateCheckSolvingMovePositions();
-    generatePins();
+void Board::generateMoves(MoveList &moves) {
+    moves.clear();
+    generatedMoves = &moves;
 
-    generateLegalMoves(colourToMove);
+    if (colourToMove == Piece::White) generateLegalMoves<Piece::White>();
+    else generateLegalMoves<Piece::Black>();
 
-    hasLegalMoves = !legalMoves.empty();
+    hasLegalMoves = !moves.empty();
 }
 
 void Board::checkIfLegalMovesExist() {
-    auto opponentColour = Piece::getOpponentColour(colourToMove);
-
-    generateSquaresAttackedByOpponent(opponentColour);
-    generatePins();
-    isKingUnderAttack = IsKingUnderAttack();
-    legalMovesExist(colourToMove);
+    if (colourToMove == Piece::White) legalMovesExist<Piece::White>();
+    else legalMovesExist<Piece::Black>();
 }
 
-void Board::makeMove(MoveVariant &move) {
+void Board::makeMove(Move move) {
     makeMoveWithoutGeneratingMoves(move);
     generateMoves();
     updateGameState();
-    updateEndgameState();
 }
 
-void Board::updateEndgameState() { _isInEndgame = determineIfIsInEndgame(); }
+void Board::unmakeMove(Move move) {
+    auto &record = undoRecords[--ply];
 
-void Board::unmakeMove(MoveVariant &move) {
-    undoCastlingPieceMovementUpdate();
-    visit(undoMoveVisitor, move);
+    undoMove(move, record.capturedPiece);
 
-    changeColourToMove();
-    kingSquare = _getKingSquare();
-    moveHistory.pop();
+    colourToMove = Piece::getOpponentColour(colourToMove);
+    castlingRights = record.castlingRights;
+    enPassantTargetSquare = record.enPassantTargetSquare;
+    kingSquare = record.kingSquare;
+    opponentKingSquare = record.opponentKingSquare;
+    zobristHash = record.zobristHash;
+    legality = record.legality;
+    isKingUnderAttack = record.isKingUnderAttack;
 }
 
 Board *Board::copy() const {
-    auto board = new Board(colourToMove, moveHistory, castlingPieceMoved, squares);
-    board->generateMoves();
-    return board;
+    return new Board(*this);
 }
 
-Board::Board() {
-    computeMoveData();
-}
-
-Board::Board(int colourToMove, std::stack<MoveVariant> moveHistory, std::unordered_map<int, bool> castlingPieceMoved,
-             std::array<int, 64> squares) {
-    this->colourToMove = colourToMove;
-    this->moveHistory = moveHistory;
-    this->castlingPieceMoved = castlingPieceMoved;
-    this->squares = squares;
-    computeMoveData();
-    updateEndgameState();
-    kingSquare = _getKingSquare();
-    opponentKingSquare = _getOpponentKingSquare();
-}
-
-void Board::computeMoveData() {
-    for (int file = 0; file < 8; file++) {
-        for (int rank = 0; rank < 8; rank++) {
-            int numNorth = 7 - rank;
-            int numSouth = rank;
-            int numWest = file;
-            int numEast = 7 - file;
-
-            int squareIndex = rank * 8 + file;
-
-            numSquaresToEdge[squareIndex][0] = numNorth;
-            numSquaresToEdge[squareIndex][1] = numSouth;
-            numSquaresToEdge[squareIndex][2] = numEast;
-            numSquaresToEdge[squareIndex][3] = numWest;
-            numSquaresToEdge[squareIndex][4] = std::min(numNorth, numWest);
-            numSquaresToEdge[squareIndex][5] = std::min(numSouth, numEast);
-            numSquaresToEdge[squareIndex][6] = std::min(numNorth, numEast);
-            numSquaresToEdge[squareIndex][7] = std::min(numSouth, numWest);
-        }
-    }
+Board::Board(const Board &other) :
+        squares(other.squares),
+        pieceBitboards(other.pieceBitboards),
+        colourBitboards(other.colourBitboards),
+        colourToMove(other.colourToMove),
+        hasLegalMoves(other.hasLegalMoves),
+        enPassantTargetSquare(other.enPassantTargetSquare),
+        isKingUnderAttack(other.isKingUnderAttack),
+        castlingRights(other.castlingRights),
+        zobristHash(other.zobristHash),
+        kingSquare(other.kingSquare),
+        opponentKingSquare(other.opponentKingSquare) {}
+
+Board::Board(const Board &other, UndoBuffer &undoBuffer) : Board(other) {
+    undoRecords = undoBuffer.data();
+    maxPly = undoBuffer.size();
+}
+
+void Board::growHistory() {
+    if (undoRecords != history.data()) history.assign(undoRecords, undoRecords + ply);
+
+    history.resize(std::max(ply * 2, (int) std::tuple_size_v<UndoBuffer>));
+    undoRecords = history.data();
+    maxPly = history.size();
 }
 
 void Board::generatePins() {
-    pins.clear();
+    legality.pinnedPieces = BitboardUtil::Empty;
+
+    auto opponentColour = Piece::getOpponentColour(colourToMove);
+    auto queens = getPieces(opponentColour, Piece::Queen);
+    auto rooks = getPieces(opponentColour, Piece::Rook) | queens;
+    auto bishops = getPieces(opponentColour, Piece::Bishop) | queens;
 
-    for (int square = 0; square < 64; square++) {
-        auto pieceType = Piece::getType(squares[square]);
+    auto snipers = (Attacks::rook(kingSquare, BitboardUtil::Empty) & rooks)
+                   | (Attacks::bishop(kingSquare, BitboardUtil::Empty) & bishops);
 
-        if (Piece::isLongRangeSlidingPiece(pieceType))
-            generatePins(pieceType, square);
+    auto occupied = getOccupiedSquares();
+    auto ownPieces = getPieces(colourToMove);
+
+    while (snipers) {
+        auto blockers = Attacks::between(kingSquare, BitboardUtil::popLsb(snipers)) & occupied;
+
+        if (BitboardUtil::popCount(blockers) == 1)
+            legality.pinnedPieces |= blockers & ownPieces;
     }
 }
 
-void Board::generatePins(int pieceType, int startSquare) {
-    int startDirIndex = pieceType == Piece::Bishop ? 4 : 0;
-    int endDirIndex = pieceType == Piece::Rook ? 4 : 8;
+void Board::setCastlingRights(int rights) {
+    zobristHash ^= ZobristHashGenerator.hashCastlingRights(castlingRights)
+                   ^ ZobristHashGenerator.hashCastlingRights(rights);
+    castlingRights = rights;
+}
 
-    auto colour = Piece::getColour(squares[startSquare]);
-    auto opponentColour = Piece::getOpponentColour(colour);
+void Board::setEnPassantTargetSquare(int square) {
+    if (enPassantTargetSquare != -1)
+        zobristHash ^= ZobristHashGenerator.hashEnPassantTargetSquare(enPassantTargetSquare);
 
-    for (int directionIndex = startDirIndex; directionIndex < endDirIndex; directionIndex++) {
-        int maxOffset = numSquaresToEdge[startSquare][directionIndex];
+    enPassantTargetSquare = square;
 
-        auto potentialPinnedPiecePosition = -1;
+    if (enPassantTargetSquare != -1)
+        zobristHash ^= ZobristHashGenerator.hashEnPassantTargetSquare(enPassantTargetSquare);
+}
 
-        for (int offset = 1; offset <= maxOffset; offset++) {
-            int targetSquare = startSquare + directionOffsets[directionIndex] * offset;
-            int targetPiece = squares[targetSquare];
+// only recorded when an enemy pawn can take, so that the other positions hash the same
+int Board::getEnPassantTargetSquareAfterMove(int movedPiece, int startSquare, int targetSquare) const {
+    if (Piece::getType(movedPiece) != Piece::Pawn || std::abs(targetSquare - startSquare) != 16)
+        return -1;
 
-            if (Piece::getColour(targetPiece) == colour) break;
+    auto pushedPawn = BitboardUtil::squareBit(targetSquare);
+    auto neighbours = ((pushedPawn << 1) & ~BitboardUtil::FileA) | ((pushedPawn >> 1) & ~BitboardUtil::FileH);
+    auto enemyPawns = getPieces(Piece::getOpponentColourFromPiece(movedPiece), Piece::Pawn);
 
-            if (potentialPinnedPiecePosition == -1) {
-                if (Piece::getColour(targetPiece) == opponentColour
-                    && Piece::getType(targetPiece) != Piece::King)
-                    potentialPinnedPiecePosition = targetSquare;
+    if (!(neighbours & enemyPawns)) return -1;
 
-                continue;
-            }
+    return (startSquare + targetSquare) / 2;
+}
 
-            if (targetPiece == Piece::None) continue;
+void Board::generateCheckBlockMask() {
+    legality.checkBlockMask = BitboardUtil::Empty;
+    legality.kingAttackerPosition = -1;
 
-            if (targetPiece == (Piece::King | opponentColour))
-                pins[potentialPinnedPiecePosition] = directionIndex;
-            else break;
-        }
-    }
+    // in double check only the king can move
+    if (!legality.checkers || BitboardUtil::popCount(legality.checkers) > 1) return;
+
+    legality.kingAttackerPosition = BitboardUtil::lsb(legality.checkers);
+    legality.checkBlockMask = legality.checkers | Attacks::between(kingSquare, legality.kingAttackerPosition);
 }
 
-void Board::undoCastlingPieceMovementUpdate() {
-    auto lastMove = castlingPieceMovementHistory.top();
+template<int colour>
+void Board::prepareLegalityChecks() {
+    if (legality.isUpToDate) return;
 
-    if (lastMove != Piece::None)
-        castlingPieceMoved[lastMove] = false;
+    generateSquaresAttackedByOpponent<Piece::OpponentColour<colour>>();
+    isKingUnderAttack = IsKingUnderAttack();
+    generateCheckBlockMask();
+    generatePins();
 
-    castlingPieceMovementHistory.pop();
+    legality.isUpToDate = true;
 }
 
-void Board::generateCheckSolvingMovePositions() {
-    unsigned int checkCount = 0;
-    checkSolvingMovePositions.clear();
-    if (!isKingUnderAttack) return;
+void Board::prepareLegalityChecks() {
+    if (colourToMove == Piece::White) prepareLegalityChecks<Piece::White>();
+    else prepareLegalityChecks<Piece::Black>();
+}
 
-    for (int square = 0; square < 64; square++) {
-        if (attacksKing[square]) {
-            kingAttackerPosition = square;
-            checkCount++;
+template<int colour>
+void Board::generateLegalMoves() {
+    prepareLegalityChecks<colour>();
 
-            if (checkCount >= 2) {
-                kingAttackerPosition = -1;
-                checkSolvingMovePositions.clear();
-                return;
-            }
+    MoveGenerationProcessor processor(this);
+    auto pieces = getPieces(colour);
 
-            checkSolvingMovePositions.insert(square);
+    while (pieces) {
+        int startSquare = BitboardUtil::popLsb(pieces);
+        int piece = squares[startSquare];
 
-            int pieceType = Piece::getType(squares[square]);
-            if (Piece::isLongRangeSlidingPiece(pieceType)) {
-                generateCheckSolvingMovePosition(pieceType, square);
-            }
-        }
+        if (Piece::isSlidingPiece(piece)) generateSlidingMoves<colour>(startSquare, piece, processor);
+        else if (Piece::getType(piece) == Piece::Pawn) generatePawnMoves<colour>(startSquare, processor);
+        else if (Piece::getType(piece) == Piece::Knight) generateKnightMoves<colour>(startSquare, processor);
     }
+
+    generateCastlingMoves<colour>(processor);
 }
 
-void Board::generateLegalMoves(int colour) {
-    for (int startSquare = 0; startSquare < 64; startSquare++) {
+template<int colour>
+void Board::generateLegalCaptures() {
+    prepareLegalityChecks<colour>();
+
+    CaptureGenerationProcessor processor(this);
+    auto pieces = getPieces(colour);
+
+    while (pieces) {
+        int startSquare = BitboardUtil::popLsb(pieces);
         int piece = squares[startSquare];
-        if (Piece::getColour(piece) != colour) continue;
 
-        if (Piece::isSlidingPiece(piece)) generateSlidingMoves(startSquare, piece, moveGenerationProcessor);
-        else if (Piece::getType(piece) == Piece::Pawn) generatePawnMoves(startSquare, piece, moveGenerationProcessor);
-        else if (Piece::getType(piece) == Piece::Knight) generateKnightMoves(startSquare, piece, moveGenerationProcessor);
+        if (Piece::isSlidingPiece(piece)) generateSlidingMoves<colour>(startSquare, piece, processor);
+        else if (Piece::getType(piece) == Piece::Pawn) generateNormalPawnCaptures<colour>(startSquare, processor);
+        else if (Piece::getType(piece) == Piece::Knight) generateKnightMoves<colour>(startSquare, processor);
     }
-
-    generateCastlingMoves(moveGenerationProcessor);
 }
 
-void Board::generateLegalCaptures(int color) {
-    for (int startSquare = 0; startSquare < 64; startSquare++) {
+template<int colour>
+void Board::generateLegalQuietMoves() {
+    prepareLegalityChecks<colour>();
+
+    QuietGenerationProcessor processor(this);
+    auto pieces = getPieces(colour);
+
+    while (pieces) {
+        int startSquare = BitboardUtil::popLsb(pieces);
         int piece = squares[startSquare];
-        if (Piece::getColour(piece) != color) continue;
 
-        if (Piece::isSlidingPiece(piece)) generateSlidingMoves(startSquare, piece, captureGenerationProcessor);
-        else if (Piece::getType(piece) == Piece::Pawn) generateNormalPawnCaptures(startSquare, piece, captureGenerationProcessor);
-        else if (Piece::getType(piece) == Piece::Knight) generateKnightMoves(startSquare, piece, captureGenerationProcessor);
+        if (Piece::isSlidingPiece(piece)) generateSlidingMoves<colour>(startSquare, piece, processor);
+        else if (Piece::getType(piece) == Piece::Pawn) generateQuietPawnMoves<colour>(startSquare, processor);
+        else if (Piece::getType(piece) == Piece::Knight) generateKnightMoves<colour>(startSquare, processor);
     }
+
+    generateCastlingMoves<colour>(processor);
 }
 
-void Board::generateSquaresAttackedByOpponent(int colour) {
-    for (int square = 0; square < 64; square++)
-        squaresAttackedByOpponent[square] = false;
+template<int colour>
+void Board::generateSquaresAttackedByOpponent() {
+    legality.squaresAttackedByOpponent = BitboardUtil::Empty;
+    legality.checkers = BitboardUtil::Empty;
 
-    for (int startSquare = 0; startSquare < 64; startSquare++) {
+    AttackedSquaresGenerationProcessor processor(this);
+
+    auto pieces = getPieces(colour);
+
+    while (pieces) {
+        int startSquare = BitboardUtil::popLsb(pieces);
         int piece = squares[startSquare];
-        attacksKing[startSquare] = false;
-        if (Piece::getColour(piece) != colour) continue;
 
-        if (Piece::isSlidingPiece(piece)) generateSlidingMoves(startSquare, piece, attackedSquaresGenerationProcessor);
-        else if (Piece::getType(piece) == Piece::Pawn) generateCapturePawnMoves(startSquare, piece, attackedSquaresGenerationProcessor, false, true);
-        else if (Piece::getType(piece) == Piece::Knight) generateKnightMoves(startSquare, piece, attackedSquaresGenerationProcessor);
+        if (Piece::isSlidingPiece(piece)) generateSlidingMoves<colour>(startSquare, piece, processor);
+        else if (Piece::getType(piece) == Piece::Pawn) generateCapturePawnMoves<colour>(startSquare, processor, false, true);
+        else if (Piece::getType(piece) == Piece::Knight) generateKnightMoves<colour>(startSquare, processor);
+    }
+}
+
+static int getPieceTypeFromSymbol(char symbol) {
+    switch (symbol) {
+        case 'k': return Piece::King;
+        case 'q': return Piece::Queen;
+        case 'r': return Piece::Rook;
+        case 'b': return Piece::Bishop;
+        case 'n': return Piece::Knight;
+        case 'p': return Piece::Pawn;
+        default: return Piece::None;
     }
 }
 
@@ -263,72 +288,67 @@ void Board::loadFenString(std::string &fenString) {
         } else if (std::isdigit(symbol)) {
             file += symbol - '0';
         } else {
-            int pieceType = pieceTypeFromSymbol[std::tolower(symbol)];
+            int pieceType = getPieceTypeFromSymbol(std::tolower(symbol));
             int pieceColor = std::isupper(symbol) ? Piece::White : Piece::Black;
 
-            squares[rank * 8 + file] = pieceType | pieceColor;
+            putPiece(rank * 8 + file, pieceType | pieceColor);
             file++;
         }
     }
 
-    kingSquare = _getKingSquare();
-    opponentKingSquare = _getOpponentKingSquare();
+    kingSquare = findKingSquare(colourToMove);
+    opponentKingSquare = findKingSquare(Piece::getOpponentColour(colourToMove));
 }
 
-void Board::updateCastlingPieceMovement(MoveVariant &move) {
-    auto basicMove = visit(GetBasicMoveVisitor, move);
-    int piece = squares[basicMove.startSquare];
-    int castlingPiece = getCastlingPiece(piece, basicMove.startSquare);
-
-    auto shouldUpdate = castlingPiece != Piece::None && !castlingPieceMoved[castlingPiece];
-
-    if (shouldUpdate)
-        castlingPieceMoved[castlingPiece] = true;
-
-    castlingPieceMovementHistory.push(shouldUpdate ? castlingPiece : 0);
-}
 
-void Board::addMoveIfLegal(MoveVariant &potentialMove) {
-    if (isMoveLegal(potentialMove))
-        legalMoves.push_back(potentialMove);
+void Board::addMoveIfLegal(Move potentialMove) {
+    if (generatesPseudoLegalMoves || isMoveLegal(potentialMove))
+        generatedMoves->push(potentialMove);
 }
 
-bool Board::isMoveLegal(MoveVariant potentialMove) const {
-    if (visit(IsCastlingMoveVisitor, potentialMove)) return true;
+bool Board::isMoveLegal(Move potentialMove) const {
+    if (potentialMove.isCastling()) return true;
 
-    auto enPassantMove = visit(GetEnPassantMoveVisitor, potentialMove);
+    auto isEnPassant = potentialMove.isEnPassant();
 
     return !violatesPin(potentialMove)
            && (!IsKingUnderAttack(potentialMove) || coversCheck(potentialMove) ||
-               (enPassantMove.has_value() && enPassantMove->capturedPawnPosition == kingAttackerPosition))
-           && (!enPassantMove.has_value() || isValidEnPassantMove(*enPassantMove));
+               (isEnPassant && potentialMove.getCapturedSquare() == legality.kingAttackerPosition))
+           && (!isEnPassant || isValidEnPassantMove(potentialMove));
 }
 
-void Board::legalMovesExist(int colour) {
-    for (int startSquare = 0; startSquare < 64; startSquare++) {
+template<int colour>
+void Board::legalMovesExist() {
+    prepareLegalityChecks<colour>();
+    hasLegalMoves = false;
+
+    LegalMoveSearchProcessor processor(this);
+    auto pieces = getPieces(colour);
+
+    while (pieces) {
+        int startSquare = BitboardUtil::popLsb(pieces);
         int piece = squares[startSquare];
-        if (Piece::getColour(piece) != colour) continue;
 
-        if (Piece::isSlidingPiece(piece)) generateSlidingMoves(startSquare, piece, legalMoveSearchProcessor);
-        else if (Piece::getType(piece) == Piece::Pawn) generatePawnMoves(startSquare, piece, legalMoveSearchProcessor);
-        else if (Piece::getType(piece) == Piece::Knight) generateKnightMoves(startSquare, piece, legalMoveSearchProcessor);
+        if (Piece::isSlidingPiece(piece)) generateSlidingMoves<colour>(startSquare, piece, processor);
+        else if (Piece::getType(piece) == Piece::Pawn) generatePawnMoves<colour>(startSquare, processor);
+        else if (Piece::getType(piece) == Piece::Knight) generateKnightMoves<colour>(startSquare, processor);
 
         if (hasLegalMoves) return;
     }
 }
 
 bool Board::IsKingUnderAttack() const {
-    return squaresAttackedByOpponent[kingSquare];
+    return BitboardUtil::contains(legality.squaresAttackedByOpponent, kingSquare);
 }
 
-bool Board::IsKingUnderAttack(MoveVariant potentialMove) const {
-    auto basicMove = visit(GetBasicMoveVisitor, potentialMove);
-    if (basicMove.startSquare != kingSquare) return isKingUnderAttack;
-    return squaresAttackedByOpponent[basicMove.targetSquare];
+bool Board::IsKingUnderAttack(Move potentialMove) const {
+    if (potentialMove.getStartSquare() != kingSquare) return isKingUnderAttack;
+    return BitboardUtil::contains(legality.squaresAttackedByOpponent, potentialMove.getTargetSquare());
 }
 
 void Board::changeColourToMove() {
     colourToMove = Piece::getOpponentColour(colourToMove);
+    zobristHash ^= ZobristHashGenerator.hashColourToMove();
 }
 
 void Board::updateGameState() {
@@ -344,136 +364,159 @@ void Board::updateGameState() {
 //        }
 }
 
-void Board::makeMoveWithoutGeneratingMoves(MoveVariant &move) {
-    updateCastlingPieceMovement(move);
-    visit(applyMoveVisitor, move);
-    changeColourToMove();
-    moveHistory.push(move);
-    kingSquare = _getKingSquare();
-    opponentKingSquare = _getOpponentKingSquare();
-    enPassantTargetSquare = -1;
-}
+void Board::makeMoveWithoutGeneratingMoves(Move move) {
+    auto startSquare = move.getStartSquare();
+    auto targetSquare = move.getTargetSquare();
+    auto movedPiece = squares[startSquare];
 
-bool Board::violatesPin(MoveVariant &move) const {
-    auto basicMove = visit(GetBasicMoveVisitor, move);
-    if (!pins.contains(basicMove.startSquare)) return false;
-    if (Piece::getType(squares[basicMove.startSquare]) == Piece::Knight) return true;
+    if (ply == maxPly) growHistory();
+    auto &record = undoRecords[ply++];
+    record.move = move;
+    record.enPassantTargetSquare = enPassantTargetSquare;
+    record.kingSquare = kingSquare;
+    record.opponentKingSquare = opponentKingSquare;
+    record.zobristHash = zobristHash;
+    record.castlingRights = castlingRights;
+    record.legality = legality;
+    record.isKingUnderAttack = isKingUnderAttack;
+    record.capturedPiece = applyMove(move);
 
-    auto directionIndex = pins.at(basicMove.startSquare);
-    auto directionOffset = directionOffsets[directionIndex];
+    legality.isUpToDate = false;
 
-    auto squareDifference = basicMove.targetSquare - basicMove.startSquare;
+    auto newCastlingRights = CastlingRights::update(castlingRights, startSquare, targetSquare);
+    if (newCastlingRights != castlingRights) setCastlingRights(newCastlingRights);
 
-    if (std::abs(directionOffset) == 1)
-        return basicMove.startSquare / 8 != basicMove.targetSquare / 8;
+    changeColourToMove();
 
-    return squareDifference % directionOffset != 0;
-}
+    auto movedKingSquare = Piece::getType(movedPiece) == Piece::King ? targetSquare : kingSquare;
+    kingSquare = opponentKingSquare;
+    opponentKingSquare = movedKingSquare;
 
-bool Board::coversCheck(MoveVariant potentialMove) const {
-    auto basicMove = visit(GetBasicMoveVisitor, potentialMove);
-    return basicMove.startSquare != kingSquare &&
-           checkSolvingMovePositions.contains(basicMove.targetSquare);
+    setEnPassantTargetSquare(getEnPassantTargetSquareAfterMove(movedPiece, startSquare, targetSquare));
 }
 
-bool Board::isValidEnPassantMove(EnPassantMove move) const {
-    auto kingFile = kingSquare / 8;
-    auto pawnFile = move.startSquare / 8;
-    if (kingFile != pawnFile) return true;
+uint64_t Board::getZobristHashAfter(Move move) const {
+    auto startSquare = move.getStartSquare();
+    auto targetSquare = move.getTargetSquare();
+    auto movedPiece = squares[startSquare];
+    auto placedPiece = move.isPromotion() ? move.getPromotionPieceType() | Piece::getColour(movedPiece) : movedPiece;
 
-    auto opponentColour = Piece::getOpponentColour(colourToMove);
+    auto hash = zobristHash
+                ^ ZobristHashGenerator.hashColourToMove()
+                ^ ZobristHashGenerator.hashPiece(startSquare, movedPiece)
+                ^ ZobristHashGenerator.hashPiece(targetSquare, placedPiece);
 
-    auto rightPawnPosition = std::max(move.startSquare, move.capturedPawnPosition);
-    auto leftPawnPosition = std::min(move.startSquare, move.capturedPawnPosition);
-    auto isKingOnTheLeft = kingSquare < leftPawnPosition;
-    auto rookDirectionIndex = isKingOnTheLeft ? rightDirectionIndex : leftDirectionIndex;
-    auto kingDirectionIndex = !isKingOnTheLeft ? rightDirectionIndex : leftDirectionIndex;
+    if (move.isCastling()) {
+        auto rook = squares[move.getCastlingRookSquare()];
+        hash ^= ZobristHashGenerator.hashPiece(move.getCastlingRookSquare(), rook)
+                ^ ZobristHashGenerator.hashPiece(move.getCastlingRookTargetSquare(), rook);
+    } else if (squares[move.getCapturedSquare()] != Piece::None) {
+        hash ^= ZobristHashGenerator.hashPiece(move.getCapturedSquare(), squares[move.getCapturedSquare()]);
+    }
 
-    auto edgePawnPosition = isKingOnTheLeft ? rightPawnPosition : leftPawnPosition;
-    auto squaresToRookEdge = numSquaresToEdge[edgePawnPosition][rookDirectionIndex];
-    auto squaresToKingEdge = numSquaresToEdge[edgePawnPosition][kingDirectionIndex];
+    hash ^= ZobristHashGenerator.hashCastlingRights(castlingRights)
+            ^ ZobristHashGenerator.hashCastlingRights(CastlingRights::update(castlingRights, startSquare, targetSquare));
 
-    auto rookDirection = isKingOnTheLeft ? 1 : -1;
+    auto newEnPassantTargetSquare = getEnPassantTargetSquareAfterMove(movedPiece, startSquare, targetSquare);
 
-    for (auto offset = 2; offset <= squaresToKingEdge; offset++) {
-        auto position = edgePawnPosition - offset * rookDirection;
-        auto piece = squares[position];
+    if (enPassantTargetSquare != -1)
+        hash ^= ZobristHashGenerator.hashEnPassantTargetSquare(enPassantTargetSquare);
 
-        if (position == kingSquare) break;
-        if (piece != Piece::None) return true;
-    }
+    if (newEnPassantTargetSquare != -1)
+        hash ^= ZobristHashGenerator.hashEnPassantTargetSquare(newEnPassantTargetSquare);
 
-    for (auto offset = 1; offset <= squaresToRookEdge; offset++) {
-        auto position = edgePawnPosition + offset * rookDirection;
-        auto piece = squares[position];
+    return hash;
+}
 
-        if (piece != Piece::None) {
-            return Piece::getColour(piece) != opponentColour
-                   || !Piece::isLongRangeSlidingPiece(Piece::getType(piece));
-        }
+int Board::applyMove(Move move) {
+    auto startSquare = move.getStartSquare();
+    auto targetSquare = move.getTargetSquare();
+    auto capturedSquare = move.getCapturedSquare();
+    auto capturedPiece = move.isCastling() ? Piece::None : squares[capturedSquare];
+
+    if (capturedPiece != Piece::None)
+        removePiece(capturedSquare);
+
+    movePiece(startSquare, targetSquare);
+
+    if (move.isCastling())
+        movePiece(move.getCastlingRookSquare(), move.getCastlingRookTargetSquare());
+
+    if (move.isPromotion()) {
+        auto colour = Piece::getColour(squares[targetSquare]);
+        removePiece(targetSquare);
+        putPiece(targetSquare, move.getPromotionPieceType() | colour);
     }
 
-    return true;
+    return capturedPiece;
 }
 
-void Board::generateCheckSolvingMovePosition(int pieceType, int startSquare) {
-    int startDirIndex = pieceType == Piece::Bishop ? 4 : 0;
-    int endDirIndex = pieceType == Piece::Rook ? 4 : 8;
+void Board::undoMove(Move move, int capturedPiece) {
+    auto startSquare = move.getStartSquare();
+    auto targetSquare = move.getTargetSquare();
 
-    auto colour = Piece::getColour(squares[startSquare]);
+    if (move.isPromotion()) {
+        auto colour = Piece::getColour(squares[targetSquare]);
+        removePiece(targetSquare);
+        putPiece(targetSquare, Piece::Pawn | colour);
+    }
 
-    for (int directionIndex = startDirIndex; directionIndex < endDirIndex; directionIndex++) {
-        int maxOffset = numSquaresToEdge[startSquare][directionIndex];
-        bool shouldAdd = false;
-        std::unordered_set<int> squares;
+    if (move.isCastling())
+        movePiece(move.getCastlingRookTargetSquare(), move.getCastlingRookSquare());
 
-        for (int offset = 1; offset <= maxOffset; offset++) {
-            int targetSquare = startSquare + directionOffsets[directionIndex] * offset;
+    movePiece(targetSquare, startSquare);
 
-            int targetPiece = this->squares[targetSquare];
+    if (capturedPiece != Piece::None)
+        putPiece(move.getCapturedSquare(), capturedPiece);
+}
 
-            if (targetPiece != Piece::None && targetPiece != (Piece::King | Piece::getOpponentColour(colour))) break;
+bool Board::violatesPin(Move move) const {
+    auto startSquare = move.getStartSquare();
+    auto targetSquare = move.getTargetSquare();
 
-            squares.insert(targetSquare);
+    return BitboardUtil::contains(legality.pinnedPieces, startSquare)
+           && !BitboardUtil::contains(Attacks::line(kingSquare, startSquare), targetSquare);
+}
 
-            if (targetPiece == (Piece::King | Piece::getOpponentColour(colour))) {
-                shouldAdd = true;
-                break;
-            }
-        }
+bool Board::coversCheck(Move potentialMove) const {
+    return potentialMove.getStartSquare() != kingSquare &&
+           BitboardUtil::contains(legality.checkBlockMask, potentialMove.getTargetSquare());
+}
 
-        if (!shouldAdd) continue;
+// taking en passant removes two pawns from one rank, which can expose the king along it
+bool Board::isValidEnPassantMove(Move move) const {
+    auto rank = BoardUtil::rank(kingSquare);
+    if (rank != BoardUtil::rank(move.getStartSquare())) return true;
 
-        for (auto square: squares)
-            checkSolvingMovePositions.insert(square);
-    }
-}
+    auto opponentColour = Piece::getOpponentColour(colourToMove);
+    auto rankSquares = Bitboard(0xFF) << (rank * 8);
+    auto occupied = getOccupiedSquares()
+                    & ~BitboardUtil::squareBit(move.getStartSquare())
+                    & ~BitboardUtil::squareBit(move.getCapturedSquare());
+    auto attackers = getPieces(opponentColour, Piece::Rook) | getPieces(opponentColour, Piece::Queen);
 
-void Board::generateCastlingMoves(MoveProcessor *processor) const {
-    if (colourToMove == Piece::White)
-        addCastlingMovesIfAvailable(4, Piece::White, processor);
-    else
-        addCastlingMovesIfAvailable(60, Piece::Black, processor);
+    return !(Attacks::rook(kingSquare, occupied) & rankSquares & attackers);
 }
 
-void Board::addCastlingMovesIfAvailable(int kingSquare, int colour, MoveProcessor *processor) const {
-    int king = squares[kingSquare];
+template<int colour, class Processor>
+void Board::generateCastlingMoves(Processor &processor) const {
+    constexpr int kingStartSquare = colour == Piece::White ? 4 : 60;
+    constexpr int rights = CastlingRights::getLeft(colour) | CastlingRights::getRight(colour);
 
-    if (king != (Piece::King | colour)) return;
+    if (!(castlingRights & rights) || isKingUnderAttack) return;
+    if (squares[kingStartSquare] != (Piece::King | colour)) return;
 
-    if (!castlingPieceMoved.at(king) && !isKingUnderAttack) {
-        addCastlingMoveIfPossible(kingSquare, kingSquare - 4, processor);
-        addCastlingMoveIfPossible(kingSquare, kingSquare + 3, processor);
-    }
+    addCastlingMoveIfPossible(kingStartSquare, kingStartSquare - 4, processor);
+    addCastlingMoveIfPossible(kingStartSquare, kingStartSquare + 3, processor);
 }
 
-void Board::addCastlingMoveIfPossible(int kingSquare, int rookSquare, MoveProcessor *processor) const {
+template<class Processor>
+void Board::addCastlingMoveIfPossible(int kingSquare, int rookSquare, Processor &processor) const {
     int directionMultiplier = rookSquare > kingSquare ? 1 : -1;
     int kingTargetSquare = kingSquare + 2 * directionMultiplier;
-    int rookTargetSquare = kingSquare + 1 * directionMultiplier;
 
     if (isCastlingPossible(kingSquare, rookSquare, kingTargetSquare))
-        processor->processMove(CastlingMove{kingSquare, kingTargetSquare, rookSquare, rookTargetSquare});
+        processor.processMove(Move(kingSquare, kingTargetSquare, Move::Castling));
 }
 
 bool Board::isCastlingPossible(int kingSquare, int rookSquare, int targetCastlingPosition) const {
@@ -481,10 +524,10 @@ bool Board::isCastlingPossible(int kingSquare, int rookSquare, int targetCastlin
     int rook = squares[rookSquare];
 
     int colour = Piece::getColour(king);
-    int rookType = rookSquare < kingSquare ? Piece::LeftRook : Piece::RightRook;
+    int right = rookSquare < kingSquare ? CastlingRights::getLeft(colour) : CastlingRights::getRight(colour);
 
     return rook == (Piece::Rook | colour) &&
-           !castlingPieceMoved.at(rookType | colour) &&
+           (castlingRights & right) &&
            allSquaresAreClearBetween(kingSquare, rookSquare) &&
            allSquaresAreNotUnderAttackBetween(kingSquare, targetCastlingPosition);
 }
@@ -499,7 +542,7 @@ bool Board::allSquaresAreNotUnderAttackBetween(int kingSquare, int targetKingPos
 }
 
 bool Board::isSquareUnderAttack(int square) const {
-    return squaresAttackedByOpponent[square];
+    return BitboardUtil::contains(legality.squaresAttackedByOpponent, square);
 }
 
 bool Board::allSquaresAreClearBetween(int firstSquare, int secondSquare) const {
@@ -513,231 +556,203 @@ bool Board::allSquaresAreClearBetween(int firstSquare, int secondSquare) const {
     return true;
 }
 
-void Board::generateSlidingMoves(int startSquare, int piece, MoveProcessor *processor) const {
-    int pieceType = Piece::getType(piece);
-    int startDirIndex = pieceType == Piece::Bishop ? 4 : 0;
-    int endDirIndex = pieceType == Piece::Rook ? 4 : 8;
-    int maxMoveLength = pieceType == Piece::King ? 1 : 7;
-    int colour = Piece::getColour(piece);
-
-    for (int directionIndex = startDirIndex; directionIndex < endDirIndex; directionIndex++) {
-        int maxOffset = std::min(maxMoveLength, numSquaresToEdge[startSquare][directionIndex]);
-        for (int offset = 1; offset <= maxOffset; offset++) {
-            auto targetSquare = startSquare + directionOffsets[directionIndex] * offset;
-            auto targetPiece = squares[targetSquare];
-
-            if (processor->shouldAddMove(targetPiece, colour))
-                processor->processMove(NormalMove{startSquare, targetSquare, targetPiece});
-
-            if (processor->shouldStopGeneratingSlidingMoves(targetPiece, colour))
-                break;
-        }
+Bitboard Board::getSlidingPieceAttacks(int startSquare, int piece, Bitboard blockers) const {
+    switch (Piece::getType(piece)) {
+        case Piece::Rook: return Attacks::rook(startSquare, blockers);
+        case Piece::Bishop: return Attacks::bishop(startSquare, blockers);
+        case Piece::Queen: return Attacks::queen(startSquare, blockers);
+        default: return Attacks::king(startSquare);
     }
 }
 
-void Board::generatePawnMoves(int startSquare, int piece, MoveProcessor *processor) const {
-    auto isAboutToPromote = BoardUtil::isPawnAboutToPromote(startSquare, piece);
+template<int colour, class Processor>
+void Board::generateSlidingMoves(int startSquare, int piece, Processor &processor) const {
+    auto attacks = getSlidingPieceAttacks(startSquare, piece, processor.getSlidingPieceBlockers(colour));
 
-    generateForwardPawnMoves(startSquare, piece, processor, isAboutToPromote);
-    generateCapturePawnMoves(startSquare, piece, processor, isAboutToPromote, false);
-    generateEnPassantMoves(startSquare, piece, processor);
+    processor.processAttacks(startSquare, attacks & processor.getTargetSquares(colour));
 }
 
-void Board::generateForwardPawnMoves(int startSquare, int piece, MoveProcessor *processor, bool isPawnAboutToPromote) const {
-    int possibleOffsets[]{8, 16};
-
-    if (!isSquareInFrontClear(startSquare, piece)) return;
+template<int colour, class Processor>
+void Board::generatePawnMoves(int startSquare, Processor &processor) const {
+    auto isAboutToPromote = BoardUtil::rank(startSquare) == PawnRanks<colour>::promotionRank;
 
-    for (int pawnOffset: possibleOffsets) {
-        int offset = Piece::isWhite(piece) ? pawnOffset : -pawnOffset;
-
-        if (pawnOffset == 16) {
-            if (!BoardUtil::isPawnAtStartSquare(startSquare, piece)) continue;
-            int pieceInFront = squares[startSquare + offset / 2];
-            if (pieceInFront != Piece::None) continue;
-        }
+    generateForwardPawnMoves<colour>(startSquare, processor, isAboutToPromote);
+    generateCapturePawnMoves<colour>(startSquare, processor, isAboutToPromote, false);
+    generateEnPassantMoves<colour>(startSquare, processor);
+}
 
-        int targetSquarePosition = startSquare + offset;
+template<int colour, class Processor>
+void Board::generateForwardPawnMoves(int startSquare, Processor &processor, bool isPawnAboutToPromote) const {
+    constexpr int forward = PawnRanks<colour>::forward;
 
-        if (!BoardUtil::isValidSquare(targetSquarePosition)) continue;
+    int targetSquare = startSquare + forward;
+    if (squares[targetSquare] != Piece::None) return;
 
-        int targetPiece = squares[targetSquarePosition];
+    generatePawnMove(startSquare, targetSquare, isPawnAboutToPromote, Piece::None, processor);
 
-        if (targetPiece != Piece::None) continue;
-        generatePawnMove(startSquare, targetSquarePosition, isPawnAboutToPromote, Piece::None, processor);
-    }
-}
+    if (BoardUtil::rank(startSquare) != PawnRanks<colour>::startRank) return;
 
-bool Board::isSquareInFrontClear(int startSquare, int piece) const {
-    int positionOfPieceInFront = startSquare + (Piece::isWhite(piece) ? 8 : -8);
-    return squares[positionOfPieceInFront] == Piece::None;
+    targetSquare += forward;
+    if (squares[targetSquare] == Piece::None)
+        generatePawnMove(startSquare, targetSquare, false, Piece::None, processor);
 }
 
-void Board::generateCapturePawnMoves(int startSquare, int piece, MoveProcessor *processor, bool isPawnAboutToPromote,
+template<int colour, class Processor>
+void Board::generateCapturePawnMoves(int startSquare, Processor &processor, bool isPawnAboutToPromote,
                                      bool canCaptureFriendly) const {
-    int file = startSquare % 8;
+    auto targets = Attacks::pawn(startSquare, Piece::getColourIndex(colour));
+    if (!canCaptureFriendly) targets &= getPieces(Piece::OpponentColour<colour>);
 
-    for (int captureOffset: pawnCaptureOffsets) {
-        int offset = Piece::isWhite(piece) ? captureOffset : -captureOffset;
-
-        if (offset == 7 && file == 0 || offset == 9 && file == 7
-            || offset == -9 && file == 0 || offset == -7 && file == 7)
-            continue;
-        int targetSquarePosition = startSquare + offset;
-
-        if (!BoardUtil::isValidSquare(targetSquarePosition)) continue;
-        int targetPiece = squares[targetSquarePosition];
-
-        if (Piece::getColour(targetPiece) == Piece::getOpponentColourFromPiece(piece) || canCaptureFriendly)
-            generatePawnMove(startSquare, targetSquarePosition, isPawnAboutToPromote, targetPiece, processor);
+    while (targets) {
+        int targetSquare = BitboardUtil::popLsb(targets);
+        generatePawnMove(startSquare, targetSquare, isPawnAboutToPromote, squares[targetSquare], processor);
     }
 }
 
-void Board::generateNormalPawnCaptures(int startSquare, int piece, MoveProcessor *processor) const {
-    bool isAboutToPromote = BoardUtil::isPawnAboutToPromote(startSquare, piece);
-    generateCapturePawnMoves(startSquare, piece, processor, isAboutToPromote, false);
-    generateEnPassantMoves(startSquare, piece, processor);
+template<int colour, class Processor>
+void Board::generateNormalPawnCaptures(int startSquare, Processor &processor) const {
+    bool isAboutToPromote = BoardUtil::rank(startSquare) == PawnRanks<colour>::promotionRank;
+    generateCapturePawnMoves<colour>(startSquare, processor, isAboutToPromote, false);
+    generateEnPassantMoves<colour>(startSquare, processor);
 }
 
-void Board::generateKnightMoves(int startSquare, int piece, MoveProcessor *processor) const {
-    int file = startSquare % 8;
-
-    for (auto offset: knightMoveOffsets) {
-        if (file >= 6 && (offset == -6 || offset == 10)
-            || file == 7 && (offset == 17 || offset == -15)
-            || file <= 1 && (offset == 6 || offset == -10)
-            || file == 0 && (offset == -17 || offset == 15))
-            continue;
-
-        int targetSquarePosition = startSquare + offset;
-        if (!BoardUtil::isValidSquare(targetSquarePosition)) continue;
-
-        int pieceInTargetSquare = squares[targetSquarePosition];
+template<int colour, class Processor>
+void Board::generateQuietPawnMoves(int startSquare, Processor &processor) const {
+    bool isAboutToPromote = BoardUtil::rank(startSquare) == PawnRanks<colour>::promotionRank;
+    generateForwardPawnMoves<colour>(startSquare, processor, isAboutToPromote);
+}
 
-        if (processor->shouldAddMove(pieceInTargetSquare, Piece::getColour(piece)))
-            processor->processMove(NormalMove{startSquare, targetSquarePosition, pieceInTargetSquare});
-    }
+template<int colour, class Processor>
+void Board::generateKnightMoves(int startSquare, Processor &processor) const {
+    auto targets = Attacks::knight(startSquare) & processor.getTargetSquares(colour);
+    processor.processAttacks(startSquare, targets);
 }
 
-void Board::generateEnPassantMoves(int square, int piece, MoveProcessor *processor) const {
-    auto file = square % 8;
-    auto rank = square / 8;
+template<int colour, class Processor>
+void Board::generateEnPassantMoves(int square, Processor &processor) const {
+    if (enPassantTargetSquare == -1) return;
 
-    if (rank != 3 && rank != 4) return;
+    if (BitboardUtil::contains(Attacks::pawn(square, Piece::getColourIndex(colour)), enPassantTargetSquare))
+        processor.processEnPassantMove(Move(square, enPassantTargetSquare, Move::EnPassant | Move::Capture));
+}
 
-    int enPassantOffsets[]{-1, 1};
+bool Board::isInEndgame() const {
+    return isSideInEndgamePosition(Piece::White) && isSideInEndgamePosition(Piece::Black);
+}
 
-    for (int offset: enPassantOffsets) {
-        if (offset == 1 && file == 7 || offset == -1 && file == 0) continue;
+bool Board::isSideInEndgamePosition(int colour) const {
+    bool hasQueen = getPieceCount(colour, Piece::Queen) > 0;
+    bool hasRook = getPieceCount(colour, Piece::Rook) > 0;
+    return !hasQueen || (!hasRook && getMinorPieceCount(colour) <= 1);
+}
 
-        int neighbourPosition = square + offset;
+int Board::getMinorPieceCount(int colour) const {
+    return getPieceCount(colour, Piece::Knight) + getPieceCount(colour, Piece::Bishop);
+}
 
-        if (!BoardUtil::isValidSquare(neighbourPosition)) return;
+int Board::findKingSquare(int colour) const {
+    auto king = getPieces(colour, Piece::King);
+    return king ? BitboardUtil::lsb(king) : -1;
+}
 
-        int neighbourPiece = squares[neighbourPosition];
-        int enemyPawn = Piece::Pawn | Piece::getOpponentColourFromPiece(piece);
+int Board::getKingSquare() const {
+    return kingSquare;
+}
 
-        if (moveHistory.empty()) continue;
+int Board::getOpponentKingSquare() const {
+    return opponentKingSquare;
+}
 
-        auto lastMove = moveHistory.top();
-        auto basicLastMove = visit(GetBasicMoveVisitor, lastMove);
+void Board::generateCaptures() {
+    generateCaptures(legalMoves);
+}
 
-        if (neighbourPiece != enemyPawn
-            || BoardUtil::rank(basicLastMove.startSquare) != BoardUtil::initialRankOfPawn(neighbourPiece)
-            || basicLastMove.targetSquare != neighbourPosition)
-            continue;
+void Board::generateCaptures(MoveList &moves, bool pseudoLegal) {
+    moves.clear();
+    generatedMoves = &moves;
+    generatesPseudoLegalMoves = pseudoLegal;
 
-        int targetPositionOffset = Piece::isWhite(piece) ? 8 : -8;
+    if (colourToMove == Piece::White) generateLegalCaptures<Piece::White>();
+    else generateLegalCaptures<Piece::Black>();
 
-        processor->processEnPassantMove(
-                {square, neighbourPosition + targetPositionOffset, neighbourPiece, neighbourPosition}
-        );
-    }
+    generatesPseudoLegalMoves = false;
+    if (!pseudoLegal) hasLegalMoves = !moves.empty();
 }
 
-bool Board::isInEndgame() const {
-    return _isInEndgame;
-}
+void Board::generateQuietMoves(MoveList &moves, bool pseudoLegal) {
+    moves.clear();
+    generatedMoves = &moves;
+    generatesPseudoLegalMoves = pseudoLegal;
 
-template<typename T>
-bool contains(std::array<T, 64> array, T element) {
-    return std::find(array.begin(), array.end(), element) != array.end();
-}
+    if (colourToMove == Piece::White) generateLegalQuietMoves<Piece::White>();
+    else generateLegalQuietMoves<Piece::Black>();
 
-bool Board::determineIfIsInEndgame() const {
-    return isSideInEndgamePosition(Piece::White) && isSideInEndgamePosition(Piece::Black);
+    generatesPseudoLegalMoves = false;
 }
 
-bool Board::isSideInEndgamePosition(int colour) const {
-    bool hasQueen = contains(squares, Piece::Queen | colour);
-    bool hasRook = contains(squares, Piece::Rook | colour);
-    return !hasQueen || !hasRook && getMinorPieceCount(colour) <= 1;
+// the masks left behind by the generation are restored by unmakeMove, so this stays valid
+bool Board::isPseudoLegalMoveLegal(Move move) const {
+    return isMoveLegal(move);
 }
 
-unsigned long Board::getMinorPieceCount(int colour) const {
-    return std::count_if(squares.begin(), squares.end(), [colour](int piece) {
-        return piece == (Piece::Knight | colour) || piece == (Piece::Bishop | colour);
-    });
+// for moves that didn't come from generating moves in this position, like killer moves
+bool Board::isLegal(Move move) {
+    prepareLegalityChecks();
+    return isPseudoLegal(move) && isMoveLegal(move);
 }
 
-int Board::_getKingSquare(int colour) const {
-    for (int square = 0; square < 64; square++) {
-        if (squares[square] == (Piece::King | colour)) return square;
-    }
+bool Board::isPseudoLegal(Move move) const {
+    if (move.isNull()) return false;
 
-    return -1;
-}
+    auto startSquare = move.getStartSquare();
+    auto targetSquare = move.getTargetSquare();
+    auto piece = squares[startSquare];
+    auto pieceType = Piece::getType(piece);
 
-int Board::_getKingSquare() const {
-    return _getKingSquare(colourToMove);
-}
+    if (Piece::getColour(piece) != colourToMove) return false;
 
-int Board::_getOpponentKingSquare() const {
-    return _getKingSquare(Piece::getOpponentColour(colourToMove));
-}
+    if (move.isCastling()) {
+        auto kingStartSquare = colourToMove == Piece::White ? 4 : 60;
+        if (pieceType != Piece::King || startSquare != kingStartSquare || isKingUnderAttack) return false;
 
-int Board::getKingSquare() const {
-    return kingSquare;
-}
+        if (targetSquare == startSquare + 2) return isCastlingPossible(startSquare, startSquare + 3, targetSquare);
+        if (targetSquare == startSquare - 2) return isCastlingPossible(startSquare, startSquare - 4, targetSquare);
+        return false;
+    }
 
-int Board::getOpponentKingSquare() const {
-    return opponentKingSquare;
-}
+    auto pawnAttacks = Attacks::pawn(startSquare, Piece::getColourIndex(colourToMove));
 
-void Board::generateCaptures() {
-    legalMoves.clear();
+    if (move.isEnPassant())
+        return pieceType == Piece::Pawn && targetSquare == enPassantTargetSquare
+               && BitboardUtil::contains(pawnAttacks, targetSquare);
 
-    int colourToMove = this->colourToMove;
-    generateSquaresAttackedByOpponent(Piece::getOpponentColour(colourToMove));
-    isKingUnderAttack = IsKingUnderAttack();
+    auto targetPiece = squares[targetSquare];
+    if (Piece::getColour(targetPiece) == colourToMove) return false;
+    if (move.isCapture() != (targetPiece != Piece::None)) return false;
 
-    generateCheckSolvingMovePositions();
-    generatePins();
+    if (pieceType == Piece::Pawn) {
+        auto promotionRank = colourToMove == Piece::White ? BoardUtil::BlackPieceRank : BoardUtil::WhitePieceRank;
+        if (move.isPromotion() != (BoardUtil::rank(targetSquare) == promotionRank)) return false;
 
-    generateLegalCaptures(colourToMove);
+        if (move.isCapture()) return BitboardUtil::contains(pawnAttacks, targetSquare);
 
-    hasLegalMoves = !legalMoves.empty();
-}
+        auto forward = colourToMove == Piece::White ? 8 : -8;
+        if (targetSquare == startSquare + forward) return true;
 
-Board::~Board() {
-    delete moveGenerationProcessor;
-    delete captureGenerationProcessor;
-    delete legalMoveSearchProcessor;
-    delete attackedSquaresGenerationProcessor;
-}
+        return targetSquare == startSquare + 2 * forward
+               && BoardUtil::isPawnAtStartSquare(startSquare, piece)
+               && squares[startSquare + forward] == Piece::None;
+    }
 
-void Board::makeMove(Move *move) {
-    MoveVariant variant = move->toVariant();
-    makeMove(variant);
-}
+    if (move.isPromotion()) return false;
+
+    if (pieceType == Piece::Knight) return BitboardUtil::contains(Attacks::knight(startSquare), targetSquare);
 
-void Board::unmakeMove(Move *move) {
-    MoveVariant variant = move->toVariant();
-    unmakeMove(variant);
+    return BitboardUtil::contains(getSlidingPieceAttacks(startSquare, piece, getOccupiedSquares()), targetSquare);
 }
 
-Move *Board::getLastMove() {
-    return visit(GetMovePointerVisitor, moveHistory.top());
+Move Board::getLastMove() const {
+    return undoRecords[ply - 1].move;
 }
 
 char getPieceLetter(int type) {
@@ -751,7 +766,7 @@ char getPieceLetter(int type) {
 }
 
 uint64_t Board::getZobristHash() const {
-    return ZobristHashGenerator.hash(this);
+    return zobristHash;
 }
 
 std::string Board::toFenString() const {
@@ -790,21 +805,17 @@ std::string Board::toFenString() const {
 }
 
 bool Board::canWhiteCastleLeft() const {
-    return !castlingPieceMoved.at(Piece::King | Piece::White)
-           && !castlingPieceMoved.at(Piece::LeftRook | Piece::White);
+    return castlingRights & CastlingRights::WhiteLeft;
 }
 
 bool Board::canWhiteCastleRight() const {
-    return !castlingPieceMoved.at(Piece::King | Piece::White)
-           && !castlingPieceMoved.at(Piece::RightRook | Piece::White);
+    return castlingRights & CastlingRights::WhiteRight;
 }
 
 bool Board::canBlackCastleLeft() const {
-    return !castlingPieceMoved.at(Piece::King | Piece::Black)
-           && !castlingPieceMoved.at(Piece::LeftRook | Piece::Black);
+    return castlingRights & CastlingRights::BlackLeft;
 }
 
 bool Board::canBlackCastleRight() const {
-    return !castlingPieceMoved.at(Piece::King | Piece::Black)
-           && !castlingPieceMoved.at(Piece::RightRook | Piece::Black);
+    return castlingRights & CastlingRights::BlackRight;
 }
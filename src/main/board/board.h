@@ -3,19 +3,24 @@
 #include <string>
 #include <array>
 #include <vector>
-#include <stack>
 #include <unordered_map>
 #include <functional>
 #include <unordered_set>
 #include "piece.h"
+#include "bitboard.h"
+#include "undo_record.h"
+#include "castling_rights.h"
 #include "../move/move.h"
-#include "../move/visitors.h"
-#include "move_processor.h"
+#include "../move/move_list.h"
+#include "zobrist_hash_generator.h"
 
 class Board {
 public:
     std::array<int, 64> squares = {0};
-    std::vector<MoveVariant> legalMoves;
+    MoveList legalMoves;
+
+    std::array<Bitboard, 7> pieceBitboards = {0};
+    std::array<Bitboard, 2> colourBitboards = {0};
 
     int colourToMove = Piece::White;
 
@@ -23,48 +28,75 @@ public:
     int enPassantTargetSquare = -1;
     bool isKingUnderAttack = false;
 
-    std::unordered_map<int, bool> castlingPieceMoved{
-            {Piece::King | Piece::White,      false},
-            {Piece::King | Piece::Black,      false},
-            {Piece::LeftRook | Piece::White,  false},
-            {Piece::RightRook | Piece::White, false},
-            {Piece::LeftRook | Piece::Black,  false},
-            {Piece::RightRook | Piece::Black, false},
-    };
-
-    std::unordered_map<char, int> pieceTypeFromSymbol = {
-            {'k', Piece::King},
-            {'q', Piece::Queen},
-            {'r', Piece::Rook},
-            {'b', Piece::Bishop},
-            {'p', Piece::Pawn},
-            {'n', Piece::Knight},
-    };
-
-    ApplyMoveVisitor applyMoveVisitor = ApplyMoveVisitor{this};
-    UndoMoveVisitor undoMoveVisitor = UndoMoveVisitor(this);
-
-    ~Board();
+    // see CastlingRights for the bits
+    int castlingRights = CastlingRights::All;
+
+    // copies the position only, with no move history to unmake
+    Board(const Board &other);
+    // a copy that records its moves in the buffer, and so never allocates unless a line outgrows it
+    Board(const Board &other, UndoBuffer &undoBuffer);
+    Board &operator=(const Board &other) = delete;
 
     void generateMoves();
+    void generateMoves(MoveList &moves);
     void generateCaptures();
+    // pseudo-legal moves have to pass isPseudoLegalMoveLegal before they can be made
+    void generateCaptures(MoveList &moves, bool pseudoLegal = false);
+    void generateQuietMoves(MoveList &moves, bool pseudoLegal = false);
+    bool isPseudoLegalMoveLegal(Move move) const;
+    bool isLegal(Move move);
     void checkIfLegalMovesExist();
-    void makeMove(MoveVariant &move);
-    void makeMove(Move *move);
-    void makeMoveWithoutGeneratingMoves(MoveVariant &move);
-    void unmakeMove(MoveVariant &move);
-    Move *getLastMove();
-    void unmakeMove(Move *move);
+    void makeMove(Move move);
+    void makeMoveWithoutGeneratingMoves(Move move);
+    void unmakeMove(Move move);
+    Move getLastMove() const;
     Board *copy() const;
 
     int getKingSquare() const;
     int getOpponentKingSquare() const;
-    int _getKingSquare(int colour) const;
-    int _getKingSquare() const;
-    int _getOpponentKingSquare() const;
+
+    void putPiece(int square, int piece) {
+        squares[square] = piece;
+        zobristHash ^= ZobristHashGenerator.hashPiece(square, piece);
+        auto bit = BitboardUtil::squareBit(square);
+        pieceBitboards[Piece::getType(piece)] |= bit;
+        colourBitboards[Piece::getColourIndex(Piece::getColour(piece))] |= bit;
+    }
+
+    void removePiece(int square) {
+        auto piece = squares[square];
+        squares[square] = Piece::None;
+        zobristHash ^= ZobristHashGenerator.hashPiece(square, piece);
+        auto bit = BitboardUtil::squareBit(square);
+        pieceBitboards[Piece::getType(piece)] &= ~bit;
+        colourBitboards[Piece::getColourIndex(Piece::getColour(piece))] &= ~bit;
+    }
+
+    void movePiece(int startSquare, int targetSquare) {
+        auto piece = squares[startSquare];
+        removePiece(startSquare);
+        putPiece(targetSquare, piece);
+    }
+
+    Bitboard getPieces(int colour) const {
+        return colourBitboards[Piece::getColourIndex(colour)];
+    }
+
+    Bitboard getPieces(int colour, int type) const {
+        return pieceBitboards[type] & getPieces(colour);
+    }
+
+    Bitboard getOccupiedSquares() const {
+        return colourBitboards[0] | colourBitboards[1];
+    }
+
+    int getPieceCount(int colour, int type) const {
+        return BitboardUtil::popCount(getPieces(colour, type));
+    }
 
     bool isInEndgame() const;
     uint64_t getZobristHash() const;
+    uint64_t getZobristHashAfter(Move move) const;
 
     bool canWhiteCastleLeft() const;
     bool canWhiteCastleRight() const;
@@ -77,88 +109,98 @@ public:
     static inline const std::string startPosition = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR/ w KQkq - 0 1";
 
 private:
-    int numSquaresToEdge[64][8];
+    // one per move made, kept in the history unless the board was copied with a buffer
+    std::vector<UndoRecord> history;
+    UndoRecord *undoRecords = nullptr;
+    int maxPly = 0;
+    int ply = 0;
 
-    std::stack<MoveVariant> moveHistory;
-    std::stack<int> castlingPieceMovementHistory;
+    MoveList *generatedMoves = &legalMoves;
+    bool generatesPseudoLegalMoves = false;
 
-    std::array<bool, 64> attacksKing;
-    std::array<bool, 64> squaresAttackedByOpponent;
-    std::unordered_set<int> checkSolvingMovePositions;
-    std::unordered_map<int, int> pins;
+    uint64_t zobristHash = 0;
+
+    LegalityMasks legality;
 
-    int kingAttackerPosition;
     int kingSquare;
     int opponentKingSquare;
-    bool _isInEndgame = false;
-
-    MoveGenerationProcessor *moveGenerationProcessor = new MoveGenerationProcessor(this);
-    CaptureGenerationProcessor *captureGenerationProcessor = new CaptureGenerationProcessor(this);
-    AttackedSquaresGenerationProcessor *attackedSquaresGenerationProcessor = new AttackedSquaresGenerationProcessor(this);
-    LegalMoveSearchProcessor *legalMoveSearchProcessor = new LegalMoveSearchProcessor(this);
 
-    Board();
+    Board() = default;
 
-    Board(int colourToMove, std::stack<MoveVariant > moveHistory,
-          std::unordered_map<int, bool> castlingPieceMoved, std::array<int, 64> squares);
-
-    void computeMoveData();
     void loadFenString(std::string &fenString);
     void generatePins();
-    void generatePins(int pieceType, int startSquare);
-    void generateSquaresAttackedByOpponent(int color);
-    void generateLegalMoves(int color);
-    void generateLegalCaptures(int color);
-    void generateCheckSolvingMovePositions();
-    void generateCheckSolvingMovePosition(int pieceType, int startSquare);
-    void generateCastlingMoves(MoveProcessor *processor) const;
-    void addCastlingMovesIfAvailable(int kingSquare, int colour, MoveProcessor *processor) const;
-    void addCastlingMoveIfPossible(int kingSquare, int rookSquare, MoveProcessor *processor) const;
+    void generateCheckBlockMask();
+
+    // templated on the side to move, so that pawn directions and castling squares are constants
+    void prepareLegalityChecks();
+    template<int colour>
+    void prepareLegalityChecks();
+    template<int colour>
+    void generateSquaresAttackedByOpponent();
+    template<int colour>
+    void generateLegalMoves();
+    template<int colour>
+    void generateLegalCaptures();
+    template<int colour>
+    void generateLegalQuietMoves();
+    template<int colour>
+    void legalMovesExist();
+    template<int colour, class Processor>
+    void generateCastlingMoves(Processor &processor) const;
+    template<class Processor>
+    void addCastlingMoveIfPossible(int kingSquare, int rookSquare, Processor &processor) const;
     bool isCastlingPossible(int kingSquare, int rookSquare, int targetCastlingPosition) const;
     bool allSquaresAreNotUnderAttackBetween(int kingSquare, int targetKingPosition) const;
     bool isSquareUnderAttack(int square) const;
     bool allSquaresAreClearBetween(int firstSquare, int secondSquare) const;
     bool isSideInEndgamePosition(int colour) const;
-    bool determineIfIsInEndgame() const;
-    void generateSlidingMoves(int startSquare, int piece, MoveProcessor *processor) const;
-    void generatePawnMoves(int startSquare, int piece, MoveProcessor *processor) const ;
-    void generateForwardPawnMoves(
-        int startSquare, int piece, MoveProcessor *processor, bool isPawnAboutToPromote
-    ) const;
-    bool isSquareInFrontClear(int startSquare, int piece) const;
-    void generateCapturePawnMoves(int startSquare, int piece, MoveProcessor *processor, bool isPawnAboutToPromote,
+    int findKingSquare(int colour) const;
+    Bitboard getSlidingPieceAttacks(int startSquare, int piece, Bitboard blockers) const;
+    template<int colour, class Processor>
+    void generateSlidingMoves(int startSquare, int piece, Processor &processor) const;
+    template<int colour, class Processor>
+    void generatePawnMoves(int startSquare, Processor &processor) const;
+    template<int colour, class Processor>
+    void generateForwardPawnMoves(int startSquare, Processor &processor, bool isPawnAboutToPromote) const;
+    template<int colour, class Processor>
+    void generateCapturePawnMoves(int startSquare, Processor &processor, bool isPawnAboutToPromote,
                                   bool canCaptureFriendly) const;
-    void generateNormalPawnCaptures(int startSquare, int piece, MoveProcessor *processor) const;
-    void generateKnightMoves(int startSquare, int piece, MoveProcessor *processor) const;
-    void generateEnPassantMoves(int square, int piece, MoveProcessor *processor) const;
-
-    void updateCastlingPieceMovement(MoveVariant &move);
-    void undoCastlingPieceMovementUpdate();
-
-    bool isMoveLegal(MoveVariant potentialMove) const;
-    bool violatesPin(MoveVariant &move) const;
-    bool coversCheck(MoveVariant potentialMove) const;
-    bool isValidEnPassantMove(EnPassantMove move) const;
-    void addMoveIfLegal(MoveVariant &move);
-    void legalMovesExist(int colour);
+    template<int colour, class Processor>
+    void generateNormalPawnCaptures(int startSquare, Processor &processor) const;
+    template<int colour, class Processor>
+    void generateQuietPawnMoves(int startSquare, Processor &processor) const;
+    template<int colour, class Processor>
+    void generateKnightMoves(int startSquare, Processor &processor) const;
+    template<int colour, class Processor>
+    void generateEnPassantMoves(int square, Processor &processor) const;
+
+    void growHistory();
+    int applyMove(Move move);
+    void undoMove(Move move, int capturedPiece);
+
+    void setCastlingRights(int rights);
+    void setEnPassantTargetSquare(int square);
+    int getEnPassantTargetSquareAfterMove(int movedPiece, int startSquare, int targetSquare) const;
+
+    bool isPseudoLegal(Move move) const;
+    bool isMoveLegal(Move potentialMove) const;
+    bool violatesPin(Move move) const;
+    bool coversCheck(Move potentialMove) const;
+    bool isValidEnPassantMove(Move move) const;
+    void addMoveIfLegal(Move move);
 
     bool IsKingUnderAttack() const;
-    bool IsKingUnderAttack(MoveVariant potentialMove) const;
+    bool IsKingUnderAttack(Move potentialMove) const;
 
     void changeColourToMove();
     void updateGameState();
 
-    constexpr static const int directionOffsets[]{8, -8, 1, -1, 7, -7, 9, -9};
-    constexpr static const int knightMoveOffsets[]{6, 10, 15, 17, -6, -10, -15, -17};
-    constexpr static const int pawnCaptureOffsets[]{7, 9};
-
-    constexpr static const int leftDirectionIndex = 3;
-    constexpr static const int rightDirectionIndex = 2;
-
-    unsigned long getMinorPieceCount(int colour) const;
-    void updateEndgameState();
+    int getMinorPieceCount(int colour) const;
 
+    template<class Derived> friend class MoveProcessor;
     friend class MoveGenerationProcessor;
+    friend class CaptureGenerationProcessor;
+    friend class QuietGenerationProcessor;
     friend class AttackedSquaresGenerationProcessor;
     friend class LegalMoveSearchProcessor;
 };
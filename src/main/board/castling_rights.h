@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include "piece.h"
+
+// a 4-bit mask, left being the a-file side
+namespace CastlingRights {
+    const int None       = 0b0000;
+    const int WhiteLeft  = 0b0001;
+    const int WhiteRight = 0b0010;
+    const int BlackLeft  = 0b0100;
+    const int BlackRight = 0b1000;
+
+    const int White = WhiteLeft | WhiteRight;
+    const int Black = BlackLeft | BlackRight;
+    const int All   = White | Black;
+
+    // the rights left after a move from or to the square
+    constexpr std::array<int, 64> keptBySquare = [] {
+        std::array<int, 64> kept{};
+        kept.fill(All);
+        kept[0] = All & ~WhiteLeft;
+        kept[4] = All & ~White;
+        kept[7] = All & ~WhiteRight;
+        kept[56] = All & ~BlackLeft;
+        kept[60] = All & ~Black;
+        kept[63] = All & ~BlackRight;
+        return kept;
+    }();
+
+    inline int update(int rights, int startSquare, int targetSquare) {
+        return rights & keptBySquare[startSquare] & keptBySquare[targetSquare];
+    }
+
+    constexpr int getLeft(int colour) {
+        return colour == Piece::White ? WhiteLeft : BlackLeft;
+    }
+
+    constexpr int getRight(int colour) {
+        return colour == Piece::White ? WhiteRight : BlackRight;
+    }
+}
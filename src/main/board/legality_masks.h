@@ -0,0 +1,14 @@
+#pragma once
+
+#include "bitboard.h"
+
+// restored by unmakeMove, so that the moves of a node can be generated in stages
+struct LegalityMasks {
+    Bitboard squaresAttackedByOpponent = 0;
+    Bitboard checkers = 0;
+    // in single check, the squares a non-king move has to land on
+    Bitboard checkBlockMask = 0;
+    Bitboard pinnedPieces = 0;
+    int kingAttackerPosition = -1;
+    bool isUpToDate = false;
+};
@@ -1,68 +1,111 @@
 #pragma once
 
-#include <vector>
+#include "bitboard.h"
+#include "board.h"
 #include "../move/move.h"
 
+// the generators are templated on the processor, so its calls are inlined rather than virtual
+template<class Derived>
 class MoveProcessor {
 public:
-    virtual void processMove(MoveVariant move) = 0;
-    virtual void processEnPassantMove(EnPassantMove move) { processMove(move); };
-    [[nodiscard]] virtual bool shouldAddMove(int targetPiece, int colour) const = 0;
-    [[nodiscard]] virtual bool shouldStopGeneratingSlidingMoves(int targetPiece, int colour) const = 0;
-};
+    explicit MoveProcessor(Board *board) : board(board) {}
 
-class MoveGenerationProcessor : public MoveProcessor {
-public:
-    explicit MoveGenerationProcessor(Board *board) :board(board) {}
-    void processMove(MoveVariant move) override;
-    void processEnPassantMove(EnPassantMove move) override;
+    void processEnPassantMove(Move move) { self().processMove(move); }
 
-    [[nodiscard]] bool shouldAddMove(int targetPiece, int colour) const override {
-        return Piece::getColour(targetPiece) != colour;
-    };
+    void processAttacks(int startSquare, Bitboard targets) {
+        while (targets) {
+            int targetSquare = BitboardUtil::popLsb(targets);
+            auto isCapture = board->squares[targetSquare] != Piece::None;
+            self().processMove(Move(startSquare, targetSquare, isCapture ? Move::Capture : Move::Normal));
+        }
+    }
+
+    [[nodiscard]] Bitboard getSlidingPieceBlockers(int) const {
+        return board->getOccupiedSquares();
+    }
 
-    [[nodiscard]] bool shouldStopGeneratingSlidingMoves(int targetPiece, int colour) const override {
-        return targetPiece != Piece::None;
-    };
 protected:
     Board *board;
+
+    Derived &self() { return static_cast<Derived &>(*this); }
 };
 
-class CaptureGenerationProcessor: public MoveGenerationProcessor {
+class MoveGenerationProcessor : public MoveProcessor<MoveGenerationProcessor> {
 public:
-    explicit CaptureGenerationProcessor(Board *board) : MoveGenerationProcessor(board) {}
+    explicit MoveGenerationProcessor(Board *board) : MoveProcessor(board) {}
 
-    void processEnPassantMove(EnPassantMove move) override;
+    void processMove(Move move) {
+        board->addMoveIfLegal(move);
+    }
 
-    [[nodiscard]] bool shouldAddMove(int targetPiece, int colour) const override {
-        return Piece::getColour(targetPiece) == Piece::getOpponentColour(colour);
-    };
+    [[nodiscard]] Bitboard getTargetSquares(int colour) const {
+        return ~board->getPieces(colour);
+    }
 };
 
-class AttackedSquaresGenerationProcessor : public MoveProcessor {
+class CaptureGenerationProcessor : public MoveProcessor<CaptureGenerationProcessor> {
 public:
-    explicit AttackedSquaresGenerationProcessor(Board *board) : board(board) {}
-    void processMove(MoveVariant move) override;
+    explicit CaptureGenerationProcessor(Board *board) : MoveProcessor(board) {}
 
-    [[nodiscard]] bool shouldAddMove(int targetPiece, int colour) const override {
-        return true;
-    };
+    void processMove(Move move) {
+        board->addMoveIfLegal(move);
+    }
+
+    [[nodiscard]] Bitboard getTargetSquares(int colour) const {
+        return board->getPieces(Piece::getOpponentColour(colour));
+    }
+};
+
+class QuietGenerationProcessor : public MoveProcessor<QuietGenerationProcessor> {
+public:
+    explicit QuietGenerationProcessor(Board *board) : MoveProcessor(board) {}
 
-    static bool isCapturable(int piece) {
-        return piece != Piece::None && Piece::getType(piece) != Piece::King;
+    void processMove(Move move) {
+        board->addMoveIfLegal(move);
     }
 
-    [[nodiscard]] bool shouldStopGeneratingSlidingMoves(int targetPiece, int colour) const override {
-        return Piece::getColour(targetPiece) == colour
-                || isCapturable(targetPiece);
+    void processEnPassantMove(Move) {}
+
+    [[nodiscard]] Bitboard getTargetSquares(int) const {
+        return ~board->getOccupiedSquares();
+    }
+};
+
+class AttackedSquaresGenerationProcessor : public MoveProcessor<AttackedSquaresGenerationProcessor> {
+public:
+    explicit AttackedSquaresGenerationProcessor(Board *board) : MoveProcessor(board) {}
+
+    void processMove(Move move) {
+        processAttacks(move.getStartSquare(), BitboardUtil::squareBit(move.getTargetSquare()));
+    }
+
+    void processAttacks(int startSquare, Bitboard targets) {
+        if (BitboardUtil::contains(targets, board->kingSquare))
+            board->legality.checkers |= BitboardUtil::squareBit(startSquare);
+
+        board->legality.squaresAttackedByOpponent |= targets;
+    }
+
+    [[nodiscard]] Bitboard getTargetSquares(int) const {
+        return ~BitboardUtil::Empty;
     };
 
-private:
-    Board *board;
+    // the attacked king can't hide from a slider by stepping back along its ray
+    [[nodiscard]] Bitboard getSlidingPieceBlockers(int colour) const {
+        auto attackedKing = board->getPieces(Piece::getOpponentColour(colour), Piece::King);
+        return board->getOccupiedSquares() & ~attackedKing;
+    }
 };
 
-class LegalMoveSearchProcessor: public MoveGenerationProcessor {
+class LegalMoveSearchProcessor : public MoveProcessor<LegalMoveSearchProcessor> {
 public:
-    explicit LegalMoveSearchProcessor(Board *board): MoveGenerationProcessor(board) {}
-    void processMove(MoveVariant move) override;
-};
\ No newline at end of file
+    explicit LegalMoveSearchProcessor(Board *board) : MoveProcessor(board) {}
+
+    void processMove(Move move) {
+        if (board->isMoveLegal(move)) board->hasLegalMoves = true;
+    }
+
+    [[nodiscard]] Bitboard getTargetSquares(int colour) const {
+        return ~board->getPieces(colour);
+    }
+};
@@ -2,14 +2,6 @@
 #include "piece.h"
 
 namespace Piece {
-    int getType(int piece) {
-        return piece & Piece::Type;
-    }
-
-    int getColour(int piece) {
-        return piece & Piece::Colour;
-    }
-
     int getOpponentColour(int colour) {
         if (colour == None) throw std::invalid_argument("expected a colour, got None");
         return colour == White ? Black : White;
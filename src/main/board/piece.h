@@ -17,25 +17,28 @@ namespace Piece {
     const int White       = 0b0001000;
     const int Black       = 0b0010000;
 
-    const int LeftRook    = 0b0100000;
-    const int RightRook   = 0b1000000;
-
     const int PawnValue   = 10000;
     const int BishopValue = 30000;
     const int KnightValue = 30000;
     const int RookValue   = 50000;
     const int QueenValue  = 90000;
 
-    int getColour(int piece);
+    inline int getType(int piece) { return piece & Type; }
+    inline int getColour(int piece) { return piece & Colour; }
+
+    inline int getColourIndex(int colour) { return colour >> 4; }
+
     int getOpponentColour(int colour);
+
+    template<int colour>
+    constexpr int OpponentColour = colour == White ? Black : White;
+
     int getOpponentColourFromPiece(int piece);
 
     bool isOfColour(int piece, int colour);
     bool isWhite(int piece);
     bool isBlack(int piece);
 
-    int getType(int piece);
-
     bool isSlidingPiece(int piece);
     bool isLongRangeSlidingPiece(int piece);
 
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "../move/move.h"
+#include "legality_masks.h"
+
+struct UndoRecord {
+    Move move;
+    int capturedPiece;
+    int castlingRights;
+    int enPassantTargetSquare;
+    int kingSquare;
+    int opponentKingSquare;
+    uint64_t zobristHash;
+    LegalityMasks legality;
+    bool isKingUnderAttack;
+};
+
+// for a board copied by a search task, see Board(const Board &, UndoBuffer &)
+using UndoBuffer = std::array<UndoRecord, 64>;
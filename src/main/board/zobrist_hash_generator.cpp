@@ -21,6 +21,17 @@ _ZobristHashGenerator::_ZobristHashGenerator() {
     for (unsigned int i = 0; i < 8; i++) {
         hashesOfFiles[i] = get64rand();
     }
+
+    std::array<uint64_t, 4> hashesOfRights;
+    for (auto &hash: hashesOfRights) hash = get64rand();
+
+    for (unsigned int rights = 0; rights < 16; rights++) {
+        castlingRightsHashes[rights] = 0;
+
+        for (unsigned int bit = 0; bit < 4; bit++) {
+            if (rights & (1 << bit)) castlingRightsHashes[rights] ^= hashesOfRights[bit];
+        }
+    }
 }
 
 uint64_t _ZobristHashGenerator::hash(const Board * const board) {
@@ -28,30 +39,14 @@ uint64_t _ZobristHashGenerator::hash(const Board * const board) {
 
     for (unsigned int square = 0; square < 64; square++) {
         auto piece = board->squares[square];
-        if (piece != 0) hash ^= hashTable[square][piece];
+        if (piece != 0) hash ^= hashPiece(square, piece);
     }
 
     if(board->colourToMove == Piece::Black)
         hash ^= isBlackHash;
 
     if(board->enPassantTargetSquare != -1)
-        hash ^= hashesOfFiles[BoardUtil::file(board->enPassantTargetSquare)];
-
-    if (board->canWhiteCastleLeft())
-        hash ^= whiteLeftCastlingHash;
-
-    if (board->canWhiteCastleRight())
-        hash ^= whiteRightCastlingHash;
-
-    if (board->canBlackCastleLeft())
-        hash ^= blackLeftCastlingHash;
-
-    if (board->canBlackCastleRight())
-        hash ^= blackRightCastlingHash;
-
-    return hash;
-}
+        hash ^= hashEnPassantTargetSquare(board->enPassantTargetSquare);
 
-uint64_t _ZobristHashGenerator::hashPiece(int square, int piece) {
-    return hashTable[square][piece];
+    return hash ^ hashCastlingRights(board->castlingRights);
 }
@@ -3,8 +3,9 @@
 #include <array>
 #include <random>
 #include <climits>
-#include "board.h"
+#include "piece.h"
 
+class Board;
 class _ZobristHashGenerator;
 extern _ZobristHashGenerator ZobristHashGenerator;
 
@@ -13,7 +14,23 @@ public:
     _ZobristHashGenerator();
 
     uint64_t hash(const Board * const board);
-    uint64_t hashPiece(int square, int piece);
+
+    uint64_t hashPiece(int square, int piece) const {
+        return hashTable[square][getPieceIndex(piece)];
+    }
+
+    uint64_t hashColourToMove() const {
+        return isBlackHash;
+    }
+
+    uint64_t hashEnPassantTargetSquare(int square) const {
+        return hashesOfFiles[square % 8];
+    }
+
+    uint64_t hashCastlingRights(int castlingRights) const {
+        return castlingRightsHashes[castlingRights];
+    }
+
 private:
     std::uniform_int_distribution<uint64_t> dis = std::uniform_int_distribution<uint64_t>(
             std::numeric_limits<uint64_t>::min(),
@@ -25,11 +42,12 @@ private:
 
     std::array<std::array<uint64_t, 12>, 64> hashTable;
     std::array<uint64_t, 8> hashesOfFiles;
-    uint64_t whiteLeftCastlingHash = get64rand();
-    uint64_t whiteRightCastlingHash = get64rand();
-    uint64_t blackLeftCastlingHash = get64rand();
-    uint64_t blackRightCastlingHash = get64rand();
+    std::array<uint64_t, 16> castlingRightsHashes;
     uint64_t isBlackHash = get64rand();
 
     uint64_t get64rand();
+
+    static int getPieceIndex(int piece) {
+        return Piece::getColourIndex(Piece::getColour(piece)) * 6 + Piece::getType(piece) - 1;
+    }
 };
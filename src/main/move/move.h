@@ -2,92 +2,56 @@
 
 #include <cstdint>
 #include <string>
-#include <array>
-#include <variant>
 #include "../board/piece.h"
 
-class Board;
-class NormalMove;
-class CastlingMove;
-class EnPassantMove;
-class PromotionMove;
-
-typedef std::variant<NormalMove, CastlingMove, EnPassantMove, PromotionMove> MoveVariant;
-
+// start square in bits 0-5, target square in 6-11 and flags in 12-15, the highest marking captures
 class Move {
 public:
-    int startSquare;
-    int targetSquare;
-
-    virtual bool canCapture() { return false; };
+    static const int Normal = 0;
+    static const int Castling = 1;
+    static const int EnPassant = 2;
+    static const int PromotionToQueen = 4;
+    static const int PromotionToRook = 5;
+    static const int PromotionToBishop = 6;
+    static const int PromotionToKnight = 7;
 
-    virtual void apply(Board &board);
-    virtual void undo(Board &board);
+    static const int Capture = 0b1000;
 
-    virtual int getCapturedSquare() { return -1; };
-    virtual uint64_t getZorbristHash(std::array<int, 64> squares);
-    virtual int getAddedValue() { return 0; };
-    std::string toString() const;
-    MoveVariant toVariant();
-protected:
-    Move(int startSquare, int targetSquare);
-};
+    constexpr Move() = default;
 
-class NormalMove : public Move {
-public:
-    int capturedPiece;
-    NormalMove(int startSquare, int targetSquare, int capturedPiece = Piece::None);
+    constexpr Move(int startSquare, int targetSquare, int flags = Normal)
+            : data(startSquare | targetSquare << 6 | flags << 12) {}
 
-    static NormalMove fromString(std::string str);
+    static Move promotion(int startSquare, int targetSquare, int pieceType, bool isCapture);
+    static Move fromString(std::string str);
 
-    void apply(Board &board) override;
-    void undo(Board &board) override;
+    int getStartSquare() const { return data & 0b111111; }
+    int getTargetSquare() const { return (data >> 6) & 0b111111; }
+    int getFlags() const { return data >> 12; }
+    int getKind() const { return getFlags() & 0b111; }
 
-    bool canCapture() override { return true; }
-    int getCapturedSquare() override { return targetSquare; }
-    bool operator==(const NormalMove& other) const;
-};
+    bool isNull() const { return data == 0; }
+    bool isCapture() const { return getFlags() & Capture; }
+    bool isCastling() const { return getKind() == Castling; }
+    bool isEnPassant() const { return getKind() == EnPassant; }
+    bool isPromotion() const { return getKind() >= PromotionToQueen; }
 
-class CastlingMove : public Move {
-public:
-    int rookSquare;
-    int rookTargetSquare;
+    int getPromotionPieceType() const;
+    int getAddedValue() const;
 
-    CastlingMove(int kingSquare, int targetSquare, int rookSquare, int rookTargetSquare);
+    // for en passant this is the square of the captured pawn, otherwise the target square
+    int getCapturedSquare() const;
 
-    void apply(Board &board) override;
-    void undo(Board &board) override;
-    bool operator==(const CastlingMove& other) const;
-};
+    int getCastlingRookSquare() const;
+    int getCastlingRookTargetSquare() const;
 
-class EnPassantMove : public NormalMove {
-public:
-    int capturedPawnPosition;
+    uint16_t getData() const { return data; }
+    static Move fromData(uint16_t data);
 
-    EnPassantMove(int startSquare, int targetSquare, int capturedPawn, int capturedPawnPosition);
-
-    void apply(Board &board) override;
-    void undo(Board &board) override;
-
-    uint64_t getZorbristHash(std::array<int, 64> squares) override;
-
-    bool canCapture() override { return false; }
-    int getCapturedSquare() override { return capturedPawnPosition; }
-    bool operator==(const EnPassantMove& other) const;
-};
-
-class PromotionMove : public NormalMove {
-public:
-    int pieceToPromoteTo;
-
-    PromotionMove(int startSquare, int targetSquare, int pieceToPromoteTo, int capturedPiece = Piece::None);
-
-    void apply(Board &board) override;
-    void undo(Board &board) override;
+    std::string toString() const;
 
-    uint64_t getZorbristHash(std::array<int, 64> squares) override;
+    bool operator==(const Move &other) const { return data == other.data; }
 
-    int getCapturedSquare() override { return targetSquare; }
-    int getAddedValue() override { return Piece::getValue(pieceToPromoteTo); }
-    bool operator==(const PromotionMove& other) const;
+private:
+    uint16_t data = 0;
 };
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include "move.h"
+
+struct ScoredMove : public Move {
+    int32_t score = 0;
+
+    ScoredMove() = default;
+    ScoredMove(Move move) : Move(move) {}
+};
+
+// inline storage for the at most 218 legal moves of a position, so that nodes never allocate
+class MoveList {
+public:
+    static const int capacity = 256;
+
+    void push(Move move) { moves[count++] = move; }
+    void clear() { count = 0; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    ScoredMove &operator[](size_t index) { return moves[index]; }
+    const ScoredMove &operator[](size_t index) const { return moves[index]; }
+
+    ScoredMove *begin() { return moves.data(); }
+    ScoredMove *end() { return moves.data() + count; }
+    const ScoredMove *begin() const { return moves.data(); }
+    const ScoredMove *end() const { return moves.data() + count; }
+
+    bool contains(Move move) const {
+        return std::find(begin(), end(), move) != end();
+    }
+
+    void moveToFront(Move move) {
+        auto position = std::find(begin(), end(), move);
+        if (position != end()) std::swap(*position, moves[0]);
+    }
+
+private:
+    std::array<ScoredMove, capacity> moves;
+    size_t count = 0;
+};
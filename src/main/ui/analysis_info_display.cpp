@@ -62,7 +62,7 @@ bool AnalysisInfoDisplay::event(QEvent *event)
     this->positionCount->setText(("Evaluated " + std::to_string(info->positionsAnalyzed) + " positions").c_str());
     this->timeElapsed->setText(("Time elapsed: " + std::to_string(info->millisElapsed) + "ms").c_str());
     this->depth->setText(("Depth: " + std::to_string(info->depthSearchedTo)).c_str());
-    this->machineMove->setText(("Last move: " + info->move->toString()).c_str());
+    this->machineMove->setText(("Last move: " + info->move.toString()).c_str());
     showAnalysisFinished();
 
     delete info;
@@ -35,14 +35,14 @@ void ChessBoardWidget::showPossibleMoveMarkers(int startSquare) {
 
     for (auto move: possibleMoves) {
         auto icons = possibleMoveIcons;
-        moves[move->targetSquare] = move;
-        possibleMoveIcons[move->targetSquare]->setVisible(true);
+        moves[move.getTargetSquare()] = move;
+        possibleMoveIcons[move.getTargetSquare()]->setVisible(true);
     }
 }
 
 void ChessBoardWidget::hidePossibleMoveMarkers() {
     for (auto icon: possibleMoveIcons) icon->setVisible(false);
-    for (int square = 0; square < 64; square++) moves[square] = nullptr;
+    moves.fill(Move());
 }
 
 void ChessBoardWidget::dragEnterEvent(QDragEnterEvent *event) {
@@ -119,18 +119,14 @@ void ChessBoardWidget::startDrag(UiPiece *child, QMouseEvent *event) {
     drag->exec(Qt::CopyAction | Qt::MoveAction, Qt::CopyAction);
 }
 
-std::vector<Move *> toMoves(std::vector<MoveVariant> moves) {
-    return VectorUtil::map<MoveVariant, Move *>(moves, [](MoveVariant &variant) {
-        return visit(GetMovePointerVisitor, variant);
-    });
-}
+std::vector<Move> ChessBoardWidget::getPossibleMoves(int startSquare) {
+    std::vector<Move> moves;
 
-std::vector<Move *> ChessBoardWidget::getPossibleMoves(int startSquare) {
-    auto allMoves = toMoves(gameManager->board->legalMoves);
+    for (auto move: gameManager->board->legalMoves) {
+        if (move.getStartSquare() == startSquare) moves.push_back(move);
+    }
 
-    return VectorUtil::filter(allMoves, [startSquare](auto move) {
-        return move->startSquare == startSquare;
-    });
+    return moves;
 }
 
 bool ChessBoardWidget::canPieceMove(int square) {
@@ -145,11 +141,11 @@ bool ChessBoardWidget::shouldStartDrag(UiPiece *child) {
 
 void ChessBoardWidget::tryToMakeMove(int square) {
     auto move = moves[square];
-    if (move != nullptr) {
+    if (!move.isNull()) {
         gameManager->makeMove(move);
         hidePossibleMoveMarkers();
         draggedIcon = nullptr;
-        for (int square = 0; square < 64; square++) moves[square] = nullptr;
+        moves.fill(Move());
     }
 }
 
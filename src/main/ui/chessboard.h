@@ -40,11 +40,11 @@ private:
     void setActiveSquare(UiPiece *piece, QMouseEvent *event);
     Icon *createPossibleMoveIcon(int square);
     void startDrag(UiPiece *child, QMouseEvent *event);
-    std::vector<Move *> getPossibleMoves(int startSquare);
+    std::vector<Move> getPossibleMoves(int startSquare);
     bool shouldStartDrag(UiPiece *child);
     bool canPieceMove(int square);
 
-    std::array<Move *, 64> moves{nullptr};
+    std::array<Move, 64> moves{};
     std::array<Icon *, 64> possibleMoveIcons;
     GameManager *gameManager;
 };
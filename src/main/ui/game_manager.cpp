@@ -19,66 +19,66 @@ void GameManager::setup(ChessBoardWidget *wdg, AnalysisInfoDisplay *info) {
     promotionDialog->setVisible(false);
 }
 
-void GameManager::makeMove(Move *move, bool isMachineMove) {
-    auto color = Piece::getColour(board->squares[move->startSquare]);
-    auto promotionMove = dynamic_cast<PromotionMove *>(move);
+void GameManager::makeMove(Move move, bool isMachineMove) {
+    auto color = Piece::getColour(board->squares[move.getStartSquare()]);
 
-    auto pieceToMove = getPieceAtSquare(move->startSquare);
-    auto pieceToCapture = getPieceAtSquare(move->targetSquare);
+    auto pieceToMove = getPieceAtSquare(move.getStartSquare());
+    auto pieceToCapture = getPieceAtSquare(move.getTargetSquare());
 
-    if (promotionMove) {
+    if (move.isPromotion()) {
         if (promotionDialog && !isMachineMove) {
-            promotionDialog->show(color, move->targetSquare, [this, move, color](int pieceType) {
+            promotionDialog->show(color, move.getTargetSquare(), [this, move, color](int pieceType) {
                 auto piece = pieceType | color;
-                MoveVariant moveToMake = PromotionMove(move->startSquare, move->targetSquare, piece);
-                board->makeMove(moveToMake);
-                getPieceAtSquare(move->targetSquare)->setPiece(piece);
+                board->makeMove(Move::promotion(move.getStartSquare(), move.getTargetSquare(), pieceType, move.isCapture()));
+                getPieceAtSquare(move.getTargetSquare())->setPiece(piece);
                 promotionDialog->setVisible(false);
                 promotionDialogBackground->setVisible(false);
                 makeMachineMoveIfNecessary();
             });
             promotionDialogBackground->setOnClickListener([this, move, pieceToMove, pieceToCapture]() {
                 if (pieceToCapture) pieceToCapture->setVisible(true);
-                pieceToMove->moveToSquare(move->startSquare);
+                pieceToMove->moveToSquare(move.getStartSquare());
                 promotionDialog->setVisible(false);
                 promotionDialogBackground->setVisible(false);
             });
 
             promotionDialogBackground->setVisible(true);
             if (pieceToCapture) pieceToCapture->removeFromBoard();
-            pieceToMove->moveToSquare(move->targetSquare);
+            pieceToMove->moveToSquare(move.getTargetSquare());
         }
 
         if (isMachineMove) {
             board->makeMove(move);
             if (pieceToCapture) pieceToCapture->removeFromBoard();
-            pieceToMove->moveToSquare(move->targetSquare);
-            pieceToMove->setPiece(promotionMove->pieceToPromoteTo);
+            pieceToMove->moveToSquare(move.getTargetSquare());
+            pieceToMove->setPiece(move.getPromotionPieceType() | color);
         }
         return;
     }
 
     board->makeMove(move);
 
-    if (move->getCapturedSquare() != -1) {
-        auto piece = getPieceAtSquare(move->getCapturedSquare());
+    if (!move.isCastling()) {
+        auto piece = getPieceAtSquare(move.getCapturedSquare());
         if (piece) {
             piece->removeFromBoard();
         }
     }
 
-    auto castlingMove = dynamic_cast<CastlingMove *>(move);
+    if (move.isCastling())
+        getPieceAtSquare(move.getCastlingRookSquare())->moveToSquare(move.getCastlingRookTargetSquare());
 
-    if (castlingMove)
-        getPieceAtSquare(castlingMove->rookSquare)->moveToSquare(castlingMove->rookTargetSquare);
-
-    pieceToMove->moveToSquare(move->targetSquare);
+    pieceToMove->moveToSquare(move.getTargetSquare());
     makeMachineMoveIfNecessary();
 }
 
 void findTheBestMove(Board *board, GameManager *gameManager) {
-    auto generator = new MoveGenerator();
-    auto machineMove = generator->getBestMove(board);
+    auto &clock = gameManager->machineClock;
+    auto start = std::chrono::steady_clock::now();
+    auto generator = new MoveGenerator(&gameManager->transpositions);
+    auto machineMove = generator->getBestMove(board, prodAiSettings, clock);
+    auto millisTaken = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    clock.remainingMillis += clock.incrementMillis - millisTaken;
     gameManager->makeMove(machineMove, true);
     gameManager->info->updateInfo(generator->analysisInfo);
     deleteInTheBackground(generator);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../board/board.h"
+#include "../ai/ai_settings.h"
+#include "../ai/time_manager.h"
 #include "piece_ui.h"
 #include "promotion_dialog.h"
 #include "analysis_info_display.h"
@@ -12,11 +14,15 @@ class AnalysisInfoDisplay;
 class GameManager {
 public:
     Board *board = Board::fromFenString(Board::startPosition);
+    // kept for the whole game, so that each search starts from what the previous ones found
+    TranspositionTable transpositions{prodAiSettings.transpositionTableSize};
+    // the time the machine has left, five minutes a game with a three second increment
+    TimeControl machineClock{5 * 60 * 1000, 3000};
 
     explicit GameManager() {};
     void setup(ChessBoardWidget *wdg, AnalysisInfoDisplay *info);
-    void makeMove(Move *move, bool isMachineMove = false);
-    void unmakeMove(Move *move);
+    void makeMove(Move move, bool isMachineMove = false);
+    void unmakeMove(Move move);
     void undoLastMove();
 
     AnalysisInfoDisplay *info;
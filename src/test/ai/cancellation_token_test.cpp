@@ -0,0 +1,23 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <tbb/parallel_for.h>
+#include "ai/cancellation_token.h"
+
+TEST(CancellationToken, CancelsTheWorkRunInItsContext) {
+    CancellationToken token;
+    std::atomic<int> iterationsRun = 0;
+    bool sawCancellation = false;
+
+    EXPECT_FALSE(token.isCancelled());
+
+    tbb::parallel_for(tbb::blocked_range<int>(0, 1000, 1), [&](tbb::blocked_range<int>) {
+        if (iterationsRun++ == 0) {
+            token.cancel();
+            sawCancellation = tbb::is_current_task_group_canceling();
+        }
+    }, token.getContext());
+
+    EXPECT_TRUE(token.isCancelled());
+    EXPECT_TRUE(sawCancellation);
+    EXPECT_LT(iterationsRun, 1000);
+}
@@ -1,13 +1,17 @@
 #include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <thread>
 #include "ai/move_generator.h"
 #include "ai/single_depth_move_generator.h"
+#include "ai/deepevalstrategy/lazy_smp.h"
 #include "ai/deepevalstrategy/sequential_deep_evaluation_strategy.h"
 
 template<class T>
 void assertAllValuesAreTheSame(std::vector<T> values) {
     auto firstValue = values[0];
 
-    for(int i = 1; i < values.size(); i++) {
+    for(size_t i = 1; i < values.size(); i++) {
         ASSERT_EQ(values[i], firstValue);
     }
 }
@@ -21,9 +25,128 @@ TEST(DeepEvaluationStrategy, AllStrategiesReturnTheSameEval) {
             singleDepthGenerator->parallelStrategy->deepEvaluate(board, 5),
             singleDepthGenerator->pvsStrategy->deepEvaluate(board, 5),
             singleDepthGenerator->parallelPvsStrategy->deepEvaluate(board, 5),
+            singleDepthGenerator->ybwcStrategy->deepEvaluate(board, 5),
+            singleDepthGenerator->abdadaStrategy->deepEvaluate(board, 5),
     };
 
     assertAllValuesAreTheSame(evals);
 
     std::cout << evals[0] << std::endl;
 }
+
+static const Base *getRootStrategy(const SingleDepthMoveGenerator &generator, SearchStrategy strategy) {
+    switch (strategy) {
+        case SearchStrategy::RootSplit: return generator.parallelPvsStrategy;
+        case SearchStrategy::Ybwc: return generator.ybwcStrategy;
+        case SearchStrategy::Abdada: return generator.abdadaStrategy;
+        // the main search of Lazy SMP is Pvs, only its helpers are parallel
+        case SearchStrategy::LazySmp: break;
+    }
+    return nullptr;
+}
+
+static Move findLegalMove(Board *board, const std::string &name) {
+    for (auto move: board->legalMoves) {
+        if (move.toString() == name) return move;
+    }
+    return {};
+}
+
+class ParallelSearch : public testing::TestWithParam<std::tuple<SearchStrategy, int>> {};
+
+// each search has a table of its own, so the parallel one can't just read the result of PVS
+TEST_P(ParallelSearch, ReturnsTheSameEvalAsPvs) {
+    auto [strategy, threadCount] = GetParam();
+    std::unique_ptr<Board> board(Board::fromFenString("r3kbnr/ppp1pppp/2n1q3/1B3b2/3P4/2N2N2/PPP2PPP/R1BQK2R b KQk - 0 1"));
+    MoveGenerator pvsParent, parallelParent;
+    SingleDepthMoveGenerator pvsGenerator(&pvsParent, board.get(), 4, 1);
+    SingleDepthMoveGenerator parallelGenerator(&parallelParent, board.get(), 4, threadCount);
+
+    ASSERT_EQ(getRootStrategy(parallelGenerator, strategy)->deepEvaluate(board.get(), 5),
+              pvsGenerator.pvsStrategy->deepEvaluate(board.get(), 5));
+}
+
+INSTANTIATE_TEST_SUITE_P(DeepEvaluationStrategy, ParallelSearch, testing::Combine(
+        testing::Values(SearchStrategy::RootSplit, SearchStrategy::Ybwc, SearchStrategy::Abdada),
+        testing::Values(1, 2, 4)));
+
+TEST(DeepEvaluationStrategy, LazySmpHelpersDeepenUntilTheSearchIsCancelled) {
+    std::unique_ptr<Board> board(Board::fromFenString(Board::startPosition));
+    MoveGenerator parent;
+    Transposition transposition;
+    auto hasReachedDepth = [&](int depth) {
+        return parent.transpositions->probe(board->getZobristHash(), transposition) && transposition.depth >= depth;
+    };
+
+    auto lazySmp = new LazySmp(&parent, board.get(), 2);
+    for (int i = 0; i < 1000 && !hasReachedDepth(5); i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    parent.cancellation.cancel();
+    delete lazySmp;
+
+    EXPECT_TRUE(hasReachedDepth(5));
+    EXPECT_TRUE(board->isLegal(transposition.bestMove));
+}
+
+// A black queen is left for the c3 pawn to take, and the window only lets winning it cut off.
+static const std::string hangingQueenFen = "rnb1kbnr/pppp1ppp/8/4p3/3q4/2P5/PP1PPPPP/RNBQKBNR w KQkq - 0 1";
+static const int64_t winsTheQueen = Piece::QueenValue / 2;
+
+TEST(DeepEvaluationStrategy, YbwcSearchesNoBrotherBeforeTheEldestOneIsDone) {
+    std::unique_ptr<Board> board(Board::fromFenString(hangingQueenFen));
+    MoveGenerator parent;
+    SingleDepthMoveGenerator generator(&parent, board.get(), 3, 4);
+    auto capture = findLegalMove(board.get(), "c3d4");
+    Transposition transposition;
+
+    // the capture is the eldest brother as the hash move, and cuts off on its own
+    parent.transpositions->store(board->getZobristHash(), {0, 0, Transposition::EXACT, capture});
+
+    EXPECT_EQ(generator.ybwcStrategy->deepEvaluate(board.get(), 4, EvalValues::min, winsTheQueen), winsTheQueen);
+
+    for (auto move: board->legalMoves) {
+        if (move == capture) continue;
+        EXPECT_FALSE(parent.transpositions->probe(board->getZobristHashAfter(move), transposition)) << move.toString();
+    }
+}
+
+TEST(DeepEvaluationStrategy, ParallelPvsSearchesNoOtherMoveAfterTheFirstCutsOff) {
+    std::unique_ptr<Board> board(Board::fromFenString(hangingQueenFen));
+    MoveGenerator parent;
+    SingleDepthMoveGenerator generator(&parent, board.get(), 3, 4);
+    auto capture = findLegalMove(board.get(), "c3d4");
+    Transposition transposition;
+
+    parent.transpositions->store(board->getZobristHash(), {0, 0, Transposition::EXACT, capture});
+
+    EXPECT_EQ(generator.parallelPvsStrategy->deepEvaluate(board.get(), 4, EvalValues::min, winsTheQueen), winsTheQueen);
+
+    for (auto move: board->legalMoves) {
+        if (move == capture) continue;
+        EXPECT_FALSE(parent.transpositions->probe(board->getZobristHashAfter(move), transposition)) << move.toString();
+    }
+}
+
+TEST(DeepEvaluationStrategy, AbdadaDefersMovesThatAreBeingSearched) {
+    std::unique_ptr<Board> board(Board::fromFenString(hangingQueenFen));
+    auto firstMove = findLegalMove(board.get(), "a2a3");
+    auto capture = findLegalMove(board.get(), "c3d4");
+    auto quietMove = findLegalMove(board.get(), "h2h3");
+
+    // searches the capture right after the hash move unless another thread is on it
+    auto searchesQuietMove = [&](bool isCaptureBeingSearched) {
+        MoveGenerator parent;
+        SingleDepthMoveGenerator generator(&parent, board.get(), 3, 1);
+        Transposition transposition;
+
+        parent.transpositions->store(board->getZobristHash(), {0, 0, Transposition::EXACT, firstMove});
+        if (isCaptureBeingSearched) parent.transpositions->markBeingSearched(board->getZobristHashAfter(capture));
+
+        EXPECT_EQ(generator.abdadaSearchStrategy->deepEvaluate(board.get(), 3, EvalValues::min, winsTheQueen), winsTheQueen);
+        return parent.transpositions->probe(board->getZobristHashAfter(quietMove), transposition);
+    };
+
+    EXPECT_FALSE(searchesQuietMove(false));
+    EXPECT_TRUE(searchesQuietMove(true));
+}
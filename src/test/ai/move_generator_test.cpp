@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <memory>
 #include <thread>
 #include "board/board.h"
 #include "ai/move_generator.h"
@@ -10,11 +11,11 @@ TEST(MoveGenerator, FindsBestMoveInPositionWithCheckmate) {
 
     std::cout << generator->analysisInfo->depthSearchedTo << std::endl;
     std::cout << generator->positionsAnalyzed << std::endl;
-    std::cout << move->toString() << std::endl;
+    std::cout << move.toString() << std::endl;
 
-    ASSERT_TRUE(move->toString() == "g8f6"
-                || move->toString() == "g8h6"
-                || move->toString() == "e7e6");
+    ASSERT_TRUE(move.toString() == "g8f6"
+                || move.toString() == "g8h6"
+                || move.toString() == "e7e6");
 }
 
 TEST(MoveGenerator, FindsBestMoveInPositionWithPotentialCaptures) {
@@ -25,7 +26,7 @@ TEST(MoveGenerator, FindsBestMoveInPositionWithPotentialCaptures) {
     std::cout << generator->analysisInfo->depthSearchedTo << std::endl;
     std::cout << generator->positionsAnalyzed << std::endl;
 
-    ASSERT_EQ(move->toString(), "c6d5");
+    ASSERT_EQ(move.toString(), "c6d5");
 }
 
 TEST(MoveGenerator, FindsCorrectBestMoveInPosition2) {
@@ -36,16 +37,16 @@ TEST(MoveGenerator, FindsCorrectBestMoveInPosition2) {
     std::cout << generator->analysisInfo->depthSearchedTo << std::endl;
     std::cout << generator->positionsAnalyzed << std::endl;
 
-    ASSERT_EQ(move->toString(), "b4f4");
+    ASSERT_EQ(move.toString(), "b4f4");
 }
 
 TEST(MoveGenerator, UsesSensiblePositioning) {
     Board *board = Board::fromFenString(Board::startPosition);
-    MoveVariant moveToMake = NormalMove::fromString("e2e4");
+    auto moveToMake = Move::fromString("e2e4");
     board->makeMove(moveToMake);
     auto generator = new MoveGenerator();
     auto move = generator->getBestMove(board);
-    std::cout << move->startSquare << " " << move->targetSquare;
+    std::cout << move.getStartSquare() << " " << move.getTargetSquare();
 }
 
 TEST(MoveGenerator, evaluationIncludesPositioning) {
@@ -72,7 +73,7 @@ TEST(MoveGenerator, GivesCheckmate) {
     std::cout << generator->positionsAnalyzed << std::endl;
     std::cout << generator->analysisInfo->depthSearchedTo << std::endl;
 
-    EXPECT_EQ(move->toString(), "c3c1");
+    EXPECT_EQ(move.toString(), "c3c1");
 }
 
 TEST(MoveGenerator, GivesCheckmateInAMoreComplexPosition) {
@@ -80,7 +81,7 @@ TEST(MoveGenerator, GivesCheckmateInAMoreComplexPosition) {
     auto generator = new MoveGenerator();
     auto move = generator->getBestMove(board);
 
-    EXPECT_EQ(move->toString(), "e3d3");
+    EXPECT_EQ(move.toString(), "e3d3");
 }
 
 TEST(MoveGenerator, DoesNotDoStupidMoves) {
@@ -89,7 +90,7 @@ TEST(MoveGenerator, DoesNotDoStupidMoves) {
     for (int i = 0; i < 20; i++) {
         auto generator = new MoveGenerator();
         auto bestMove = generator->getBestMove(board);
-        ASSERT_EQ(bestMove->toString(), "f8b4");
+        ASSERT_EQ(bestMove.toString(), "f8b4");
         std::cout << i + 1 << " / 20" << std::endl;
     }
 }
@@ -100,7 +101,7 @@ TEST(MoveGenerator, DoesNotDoStupidMoves_2) {
     for (int i = 0; i < 50; i++) {
         auto generator = new MoveGenerator();
         auto bestMove = generator->getBestMove(board);
-        ASSERT_EQ(bestMove->toString(), "b6d4");
+        ASSERT_EQ(bestMove.toString(), "b6d4");
         std::cout << i + 1 << " / 50" << std::endl;
     }
 }
@@ -111,7 +112,7 @@ TEST(MoveGenerator, DoesNotDoStupidMoves_3) {
     for (int i = 0; i < 20; i++) {
         auto generator = new MoveGenerator();
         auto bestMove = generator->getBestMove(board);
-        ASSERT_EQ(bestMove->toString(), "d7d5");
+        ASSERT_EQ(bestMove.toString(), "d7d5");
         std::cout << i + 1 << " / 20" << std::endl;
     }
 }
@@ -122,9 +123,62 @@ TEST(MoveGenerator, DoesNotDoStupidMoves_4) {
     for (int i = 0; i < 100; i++) {
         auto generator = new MoveGenerator();
         auto bestMove = generator->getBestMove(board);
-        std::cout << bestMove->toString() << std::endl;
+        std::cout << bestMove.toString() << std::endl;
         std::cout << generator->analysisInfo->depthSearchedTo << std::endl;
-        ASSERT_TRUE(bestMove->toString() == "g8f6" || bestMove->toString() == "a7a6");
+        ASSERT_TRUE(bestMove.toString() == "g8f6" || bestMove.toString() == "a7a6");
         std::cout << i + 1 << " / 100" << std::endl;
     }
 }
+
+TEST(MoveGenerator, FindsBestMoveWithEveryStrategyAndThreadCount) {
+    auto board = Board::fromFenString("rnbqkbnr/pppppppp/8/8/2B5/5Q2/PPPPPPPP/RNBQKBNR b KQkq - 0 1", Piece::Black);
+    auto strategies = {SearchStrategy::RootSplit, SearchStrategy::LazySmp, SearchStrategy::Ybwc, SearchStrategy::Abdada};
+
+    for (auto strategy: strategies) {
+        for (int threadCount: {1, 4}) {
+            MoveGenerator generator;
+            auto settings = AiSettings{.useThreading = true, .searchStrategy = strategy, .threadCount = threadCount};
+            auto move = generator.getBestMove(board, settings, TimeControl::perMove(500));
+
+            ASSERT_TRUE(move.toString() == "g8f6"
+                        || move.toString() == "g8h6"
+                        || move.toString() == "e7e6") << move.toString();
+        }
+    }
+}
+
+TEST(MoveGenerator, SizesItsOwnTranspositionTableFromTheSettings) {
+    auto board = Board::fromFenString(Board::startPosition);
+    MoveGenerator generator;
+    generator.getBestMove(board, AiSettings{.useThreading = true, .transpositionTableSize = 1});
+
+    EXPECT_EQ(generator.transpositions->getSize(), 1);
+
+    TranspositionTable shared(2);
+    MoveGenerator generatorWithSharedTable(&shared);
+    generatorWithSharedTable.getBestMove(board, AiSettings{.useThreading = true, .transpositionTableSize = 1});
+
+    EXPECT_EQ(shared.getSize(), 2);
+}
+
+TEST(MoveGenerator, SpendsAFixedTimePerMoveInFull) {
+    auto board = Board::fromFenString(Board::startPosition);
+    MoveGenerator generator;
+    auto start = steady_clock::now();
+    generator.getBestMove(board, prodAiSettings, TimeControl::perMove(300));
+
+    EXPECT_GE(duration_cast<milliseconds>(steady_clock::now() - start).count(), 300);
+}
+
+TEST(MoveGenerator, SearchesAgainInFullWhenReused) {
+    std::unique_ptr<Board> board(Board::fromFenString(Board::startPosition));
+    std::unique_ptr<Board> checkmate(Board::fromFenString("rnbqkbnr/ppppp2p/5p2/6p1/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 1"));
+    MoveGenerator generator;
+    generator.getBestMove(board.get(), prodAiSettings, TimeControl::perMove(300));
+
+    auto start = steady_clock::now();
+    auto move = generator.getBestMove(checkmate.get(), prodAiSettings, TimeControl::perMove(300));
+
+    EXPECT_GE(duration_cast<milliseconds>(steady_clock::now() - start).count(), 300);
+    EXPECT_EQ(move.toString(), "d1h5");
+}
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include "ai/move_picker.h"
+#include "board/board_squares.h"
+
+static MoveList pickAll(MovePicker &picker) {
+    MoveList moves;
+    for (auto move = picker.next(); !move.isNull(); move = picker.next())
+        moves.push(move);
+    return moves;
+}
+
+TEST(MovePicker, HandsOutEveryLegalMoveOnce) {
+    auto board = Board::fromFenString("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -");
+    MovePicker picker(board, Move::fromString("e2a6"), Move::fromString("a2a3"), Move::fromString("e1g1"));
+
+    auto moves = pickAll(picker);
+    EXPECT_EQ(moves.size(), board->legalMoves.size());
+
+    for (auto move: board->legalMoves)
+        EXPECT_EQ(std::count(moves.begin(), moves.end(), move), 1) << move.toString();
+}
+
+TEST(MovePicker, StartsWithTheHashMoveThenCapturesThenKillers) {
+    auto board = Board::fromFenString("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -");
+    auto hashMove = Move(BoardSquares::d5, BoardSquares::d6);
+    auto killer = Move(BoardSquares::a2, BoardSquares::a3);
+    MovePicker picker(board, hashMove, killer);
+
+    EXPECT_EQ(picker.next(), hashMove);
+    EXPECT_TRUE(picker.next().isCapture());
+
+    Move move;
+    do move = picker.next(); while (move.isCapture());
+    EXPECT_EQ(move, killer);
+}
+
+TEST(MovePicker, SkipsIllegalHashAndKillerMoves) {
+    auto board = Board::fromFenString(Board::startPosition);
+    MovePicker picker(board, Move(BoardSquares::e2, BoardSquares::e5), Move(BoardSquares::e1, BoardSquares::g1, Move::Castling));
+
+    auto moves = pickAll(picker);
+    EXPECT_EQ(moves.size(), 20);
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include <tbb/parallel_for.h>
+#include "ai/shared_bound.h"
+#include "ai/constants.h"
+#include "board/board_squares.h"
+
+TEST(SharedBound, OnlyEverGoesUp) {
+    auto firstMove = Move(BoardSquares::e2, BoardSquares::e4);
+    auto secondMove = Move(BoardSquares::d2, BoardSquares::d4);
+    SharedBound bound(-50, firstMove);
+
+    EXPECT_FALSE(bound.raise(-80, secondMove));
+    EXPECT_FALSE(bound.raise(-50, secondMove));
+    EXPECT_EQ(bound.getValue(), -50);
+    EXPECT_EQ(bound.getMove(), firstMove);
+
+    EXPECT_TRUE(bound.raise(30, secondMove));
+    EXPECT_EQ(bound.getValue(), 30);
+    EXPECT_EQ(bound.getMove(), secondMove);
+}
+
+TEST(SharedBound, KeepsCheckmateScoresExact) {
+    SharedBound bound(EvalValues::min);
+
+    EXPECT_EQ(bound.getValue(), EvalValues::min);
+    EXPECT_TRUE(bound.raise(EvalValues::checkmate + 3, {}));
+    EXPECT_EQ(bound.getValue(), EvalValues::checkmate + 3);
+    EXPECT_TRUE(bound.raise(-(EvalValues::checkmate + 3), {}));
+    EXPECT_EQ(bound.getValue(), -(EvalValues::checkmate + 3));
+}
+
+TEST(SharedBound, KeepsTheMoveOfTheHighestValueRaisedConcurrently) {
+    SharedBound bound(EvalValues::min);
+
+    tbb::parallel_for(0, 4096, [&bound](int i) {
+        bound.raise(i, Move::fromData(i & 0xFFF));
+    });
+
+    EXPECT_EQ(bound.getValue(), 4095);
+    EXPECT_EQ(bound.getMove().getData(), 4095);
+}
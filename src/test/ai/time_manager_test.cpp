@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "ai/time_manager.h"
+#include "board/board_squares.h"
+
+static const Move e2e4 = Move(BoardSquares::e2, BoardSquares::e4);
+static const Move d2d4 = Move(BoardSquares::d2, BoardSquares::d4);
+
+TEST(TimeManager, SharesTheClockBetweenTheRemainingMoves) {
+    TimeManager suddenDeath({30020});
+    EXPECT_EQ(suddenDeath.getSoftLimit(), 1000);
+    EXPECT_EQ(suddenDeath.getHardLimit(), 4000);
+
+    TimeManager withIncrement({30020, 2000});
+    EXPECT_EQ(withIncrement.getSoftLimit(), 2500);
+    EXPECT_EQ(withIncrement.getHardLimit(), 10000);
+
+    TimeManager withMovesToGo({10020, 0, 10});
+    EXPECT_EQ(withMovesToGo.getSoftLimit(), 1000);
+    EXPECT_EQ(withMovesToGo.getHardLimit(), 4000);
+
+    TimeManager lastMove({1020, 0, 1});
+    EXPECT_EQ(lastMove.getSoftLimit(), 1000);
+    EXPECT_EQ(lastMove.getHardLimit(), 1000);
+
+    TimeManager perMove(TimeControl::perMove(1000));
+    EXPECT_EQ(perMove.getSoftLimit(), 1000);
+    EXPECT_EQ(perMove.getHardLimit(), 1000);
+}
+
+TEST(TimeManager, NeverTakesMoreThanHalfOfTheClock) {
+    TimeManager timeManager({420, 4000});
+
+    EXPECT_EQ(timeManager.getHardLimit(), 200);
+    EXPECT_EQ(timeManager.getSoftLimit(), 200);
+}
+
+TEST(TimeManager, ThinksLongerWhenTheBestMoveChanges) {
+    TimeManager stable({30020});
+    stable.onIterationFinished(e2e4, 100, 300);
+    stable.onIterationFinished(e2e4, 100, 600);
+
+    EXPECT_EQ(stable.getExtendedSoftLimit(), 1000);
+    EXPECT_FALSE(stable.shouldStartNextIteration(1200));
+
+    TimeManager unstable({30020});
+    unstable.onIterationFinished(e2e4, 100, 300);
+    unstable.onIterationFinished(d2d4, 100, 600);
+
+    EXPECT_EQ(unstable.getExtendedSoftLimit(), 1500);
+    EXPECT_TRUE(unstable.shouldStartNextIteration(1200));
+}
+
+TEST(TimeManager, ThinksLongerWhenTheScoreDrops) {
+    TimeManager timeManager({30020});
+    timeManager.onIterationFinished(e2e4, 0, 100);
+    timeManager.onIterationFinished(e2e4, -Piece::PawnValue, 200);
+
+    EXPECT_EQ(timeManager.getExtendedSoftLimit(), 1500);
+
+    timeManager.onIterationFinished(e2e4, -Piece::PawnValue, 300);
+
+    EXPECT_EQ(timeManager.getExtendedSoftLimit(), 1000);
+}
+
+TEST(TimeManager, DoesNotStartAnIterationThatCannotFinish) {
+    TimeManager timeManager({1020, 0, 1});
+    timeManager.onIterationFinished(e2e4, 0, 100);
+    timeManager.onIterationFinished(e2e4, 0, 300);
+
+    EXPECT_TRUE(timeManager.shouldStartNextIteration(300));
+
+    timeManager.onIterationFinished(e2e4, 0, 600);
+
+    EXPECT_FALSE(timeManager.shouldStartNextIteration(600));
+}
+
+TEST(TimeManager, UsesUpAFixedTimePerMove) {
+    TimeManager timeManager(TimeControl::perMove(1000));
+    timeManager.onIterationFinished(e2e4, 0, 100);
+    timeManager.onIterationFinished(e2e4, 0, 600);
+
+    EXPECT_TRUE(timeManager.shouldStartNextIteration(600));
+    EXPECT_TRUE(timeManager.shouldStartNextIteration(999));
+    EXPECT_FALSE(timeManager.shouldStartNextIteration(1000));
+}
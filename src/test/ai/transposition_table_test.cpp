@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "ai/transposition_table.h"
+#include "ai/constants.h"
+#include "board/board_squares.h"
+
+TEST(TranspositionTable, ReturnsWhatWasStored) {
+    TranspositionTable table(1);
+    Transposition transposition;
+
+    EXPECT_FALSE(table.probe(12345, transposition));
+
+    table.store(12345, {-4200, 5, Transposition::LOWER});
+
+    ASSERT_TRUE(table.probe(12345, transposition));
+    EXPECT_EQ(transposition.value, -4200);
+    EXPECT_EQ(transposition.depth, 5);
+    EXPECT_EQ(transposition.type, Transposition::LOWER);
+}
+
+TEST(TranspositionTable, KeepsCheckmateScoresExact) {
+    TranspositionTable table(1);
+    Transposition transposition;
+
+    for (auto value: {EvalValues::min, EvalValues::checkmate - 7, -(EvalValues::checkmate - 7), EvalValues::max}) {
+        table.store(1, {value, 3, Transposition::EXACT});
+
+        ASSERT_TRUE(table.probe(1, transposition));
+        EXPECT_EQ(transposition.value, value);
+    }
+}
+
+TEST(TranspositionTable, KeepsTheDeeperResultForAPosition) {
+    TranspositionTable table(1);
+    Transposition transposition;
+
+    table.store(7, {100, 6, Transposition::EXACT});
+    table.store(7, {200, 4, Transposition::EXACT});
+
+    ASSERT_TRUE(table.probe(7, transposition));
+    EXPECT_EQ(transposition.value, 100);
+
+    table.store(7, {300, 6, Transposition::UPPER});
+
+    ASSERT_TRUE(table.probe(7, transposition));
+    EXPECT_EQ(transposition.value, 300);
+}
+
+TEST(TranspositionTable, ReplacesTheShallowestEntryOfAFullBucket) {
+    TranspositionTable table(1);
+    Transposition transposition;
+
+    // hashes that differ only above the bucket index land in the same bucket
+    for (uint64_t i = 1; i <= 4; i++)
+        table.store(i << 32, {0, (int) i, Transposition::EXACT});
+
+    table.store(5ull << 32, {0, 3, Transposition::EXACT});
+
+    EXPECT_FALSE(table.probe(1ull << 32, transposition));
+
+    for (uint64_t i = 2; i <= 5; i++)
+        EXPECT_TRUE(table.probe(i << 32, transposition));
+}
+
+TEST(TranspositionTable, ReplacesEntriesFromEarlierSearchesFirst) {
+    TranspositionTable table(1);
+    Transposition transposition;
+
+    for (uint64_t i = 1; i <= 4; i++)
+        table.store(i << 32, {0, 4, Transposition::EXACT});
+
+    table.newSearch();
+    table.store(1ull << 32, {0, 2, Transposition::EXACT});
+    table.store(5ull << 32, {0, 1, Transposition::EXACT});
+
+    ASSERT_TRUE(table.probe(1ull << 32, transposition));
+    EXPECT_EQ(transposition.depth, 2);
+    EXPECT_TRUE(table.probe(5ull << 32, transposition));
+}
+
+TEST(TranspositionTable, KeepsTheBestMoveWhenANewSearchFindsNone) {
+    TranspositionTable table(1);
+    Transposition transposition;
+    auto move = Move(BoardSquares::e2, BoardSquares::e4);
+
+    table.store(9, {50, 2, Transposition::EXACT, move});
+
+    ASSERT_TRUE(table.probe(9, transposition));
+    EXPECT_EQ(transposition.bestMove, move);
+
+    table.store(9, {-30, 3, Transposition::UPPER});
+
+    ASSERT_TRUE(table.probe(9, transposition));
+    EXPECT_EQ(transposition.value, -30);
+    EXPECT_EQ(transposition.bestMove, move);
+}
+
+TEST(TranspositionTable, FitsAsManyBucketsAsTheSizeAllows) {
+    TranspositionTable table(3);
+    Transposition transposition;
+
+    // 64-byte buckets, rounded down to a power of two
+    EXPECT_EQ(table.getBucketCount(), 1 << 15);
+    EXPECT_EQ(table.getSize(), 3);
+
+    table.store(1, {0, 1, Transposition::EXACT});
+    table.resize(4);
+
+    EXPECT_EQ(table.getBucketCount(), 1 << 16);
+    EXPECT_EQ(table.getSize(), 4);
+    EXPECT_FALSE(table.probe(1, transposition));
+}
+
+TEST(TranspositionTable, RemembersPositionsBeingSearchedApartFromTheEntries) {
+    TranspositionTable table(1);
+    Transposition transposition;
+
+    table.markBeingSearched(42);
+
+    EXPECT_TRUE(table.isBeingSearched(42));
+    EXPECT_FALSE(table.isBeingSearched(43));
+    EXPECT_FALSE(table.probe(42, transposition));
+
+    table.unmarkBeingSearched(42);
+
+    EXPECT_FALSE(table.isBeingSearched(42));
+}
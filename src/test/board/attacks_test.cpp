@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../../main/board/attacks.h"
+#include "../../main/board/board_squares.h"
+
+TEST(Attacks, SlidingAttacksMatchRayWalkForRandomOccupancies) {
+    std::mt19937_64 random(42);
+
+    for (int square = 0; square < 64; square++) {
+        for (int i = 0; i < 200; i++) {
+            Bitboard occupied = random() & random();
+
+            ASSERT_EQ(Attacks::rook(square, occupied), Attacks::slidingAttacksByRayWalk(square, occupied, true));
+            ASSERT_EQ(Attacks::bishop(square, occupied), Attacks::slidingAttacksByRayWalk(square, occupied, false));
+        }
+    }
+}
+
+TEST(Attacks, RookIsBlockedByFirstPieceInEachDirection) {
+    Bitboard occupied = BitboardUtil::squareBit(BoardSquares::a4) | BitboardUtil::squareBit(BoardSquares::a6);
+    auto attacks = Attacks::rook(BoardSquares::a1, occupied);
+
+    EXPECT_TRUE(BitboardUtil::contains(attacks, BoardSquares::a4));
+    EXPECT_FALSE(BitboardUtil::contains(attacks, BoardSquares::a5));
+    EXPECT_TRUE(BitboardUtil::contains(attacks, BoardSquares::h1));
+    EXPECT_EQ(BitboardUtil::popCount(attacks), 10);
+}
+
+TEST(Attacks, KingAttacks) {
+    EXPECT_EQ(BitboardUtil::popCount(Attacks::king(BoardSquares::a1)), 3);
+    EXPECT_EQ(BitboardUtil::popCount(Attacks::king(BoardSquares::e4)), 8);
+    EXPECT_EQ(BitboardUtil::popCount(Attacks::king(BoardSquares::h5)), 5);
+}
+
+TEST(Attacks, BetweenAndLine) {
+    auto between = Attacks::between(BoardSquares::c1, BoardSquares::f4);
+
+    EXPECT_EQ(BitboardUtil::popCount(between), 2);
+    EXPECT_TRUE(BitboardUtil::contains(between, BoardSquares::d2));
+    EXPECT_TRUE(BitboardUtil::contains(between, BoardSquares::e3));
+
+    EXPECT_EQ(Attacks::line(BoardSquares::c1, BoardSquares::f4), Attacks::line(BoardSquares::h6, BoardSquares::d2));
+    EXPECT_EQ(BitboardUtil::popCount(Attacks::line(BoardSquares::a1, BoardSquares::a2)), 8);
+
+    EXPECT_EQ(Attacks::between(BoardSquares::a1, BoardSquares::b3), BitboardUtil::Empty);
+    EXPECT_EQ(Attacks::line(BoardSquares::a1, BoardSquares::b3), BitboardUtil::Empty);
+}
+
+TEST(Attacks, KnightAndPawnAttacksStayOnTheBoard) {
+    EXPECT_EQ(BitboardUtil::popCount(Attacks::knight(BoardSquares::a1)), 2);
+    EXPECT_EQ(BitboardUtil::popCount(Attacks::knight(BoardSquares::h5)), 4);
+    EXPECT_EQ(BitboardUtil::popCount(Attacks::knight(BoardSquares::e4)), 8);
+
+    EXPECT_EQ(Attacks::pawn(BoardSquares::a2, 0), BitboardUtil::squareBit(BoardSquares::b3));
+    EXPECT_EQ(Attacks::pawn(BoardSquares::h7, 1), BitboardUtil::squareBit(BoardSquares::g6));
+}
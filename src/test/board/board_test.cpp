@@ -13,22 +13,69 @@ TEST(Board, IsInEndgame) {
     ASSERT_FALSE(Board::fromFenString("q7/1kr5/8/8/8/8/8/4K3 w - - 0 1")->isInEndgame());
 }
 
+TEST(Board, IsInEndgameFollowsMovesMadeDuringSearch) {
+    auto board = Board::fromFenString("q7/1kr5/8/8/8/8/8/R3K3 w - - 0 1");
+    auto move = Move(BoardSquares::a1, BoardSquares::a8, Move::Capture);
+    ASSERT_FALSE(board->isInEndgame());
+
+    board->makeMoveWithoutGeneratingMoves(move);
+    EXPECT_TRUE(board->isInEndgame());
+
+    board->unmakeMove(move);
+    EXPECT_FALSE(board->isInEndgame());
+}
+
+TEST(Board, IsSmallEnoughToCopyOntoTheStackOfASearchTask) {
+    EXPECT_LT(sizeof(Board), 4096);
+}
+
+TEST(Board, RecordsTheMovesOfACopyInItsBuffer) {
+    auto board = Board::fromFenString(Board::startPosition);
+    UndoBuffer undoBuffer;
+    Board copy(*board, undoBuffer);
+
+    copy.makeMove(Move::fromString("g1f3"));
+
+    EXPECT_EQ(undoBuffer[0].move, Move::fromString("g1f3"));
+    EXPECT_EQ(undoBuffer[0].zobristHash, board->getZobristHash());
+}
+
+// far longer than the buffer, whose records then move into the history of the copy
+TEST(Board, UnmakesLinesOfAnyLength) {
+    auto board = Board::fromFenString(Board::startPosition);
+    UndoBuffer undoBuffer;
+    Board copy(*board, undoBuffer);
+    auto line = {Move::fromString("g1f3"), Move::fromString("g8f6"), Move::fromString("f3g1"), Move::fromString("f6g8")};
+    const int repetitions = 600;
+
+    for (int i = 0; i < repetitions; i++) {
+        for (auto move: line) copy.makeMove(move);
+    }
+
+    for (int i = 0; i < repetitions; i++) {
+        for (auto move = std::rbegin(line); move != std::rend(line); move++) copy.unmakeMove(*move);
+    }
+
+    EXPECT_EQ(copy.getZobristHash(), board->getZobristHash());
+    EXPECT_EQ(copy.toFenString(), board->toFenString());
+}
+
 TEST(Board, generateCaptureMoves) {
     auto board = Board::fromFenString("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1");
     board->generateCaptures();
     EXPECT_EQ(board->legalMoves.size(), 1);
-    auto expectedMove = visit(GetMovePointerVisitor, board->legalMoves[0]);
-    EXPECT_EQ(expectedMove->startSquare, BoardSquares::b4);
-    EXPECT_EQ(expectedMove->targetSquare, BoardSquares::f4);
+    auto expectedMove = board->legalMoves[0];
+    EXPECT_EQ(expectedMove.getStartSquare(), BoardSquares::b4);
+    EXPECT_EQ(expectedMove.getTargetSquare(), BoardSquares::f4);
 
-    MoveVariant move = NormalMove::fromString("b4c4");
+    auto move = Move::fromString("b4c4");
     board->makeMoveWithoutGeneratingMoves(move);
 
     board->generateCaptures();
-    auto expectedMove2 = visit(GetMovePointerVisitor, board->legalMoves[0]);
+    auto expectedMove2 = board->legalMoves[0];
     EXPECT_EQ(board->legalMoves.size(), 1);
-    EXPECT_EQ(expectedMove2->startSquare, BoardSquares::h5);
-    EXPECT_EQ(expectedMove2->targetSquare, BoardSquares::b5);
+    EXPECT_EQ(expectedMove2.getStartSquare(), BoardSquares::h5);
+    EXPECT_EQ(expectedMove2.getTargetSquare(), BoardSquares::b5);
 }
 
 void assertToFenStringWorksInPosition(std::string position) {
@@ -43,28 +90,28 @@ TEST(Board, toFenString) {
 
 TEST(Board, enPassantTargetSquare_is_negativeOneIfThereAreNoEnPassantMoves) {
     auto board = Board::fromFenString("rnbqkbnr/pppp1ppp/8/8/3pP3/8/PPP2PPP/RNBQKBNR w KQkq - 0 1");
-    MoveVariant move = NormalMove::fromString("c2c3");
+    auto move = Move::fromString("c2c3");
     board->makeMove(move);
     ASSERT_EQ(board->enPassantTargetSquare, -1);
 }
 
 TEST(Board, enPassantTargetSquare_is_squareTargetedByEnPassant) {
     auto board = Board::fromFenString("rnbqkbnr/pppp1ppp/8/8/3pP3/8/PPP2PPP/RNBQKBNR w KQkq - 0 1");
-    MoveVariant move = NormalMove::fromString("c2c4");
+    auto move = Move::fromString("c2c4");
     board->makeMove(move);
     ASSERT_EQ(board->enPassantTargetSquare, BoardSquares::c3);
 
     auto otherBoard = Board::fromFenString("rnbqkbnr/pppp1ppp/8/8/2Pp4/8/PP2PPPP/RNBQKBNR w KQkq - 0 1");
-    MoveVariant otherMove = NormalMove::fromString("e2e4");
+    auto otherMove = Move::fromString("e2e4");
     otherBoard->makeMove(otherMove);
     ASSERT_EQ(otherBoard->enPassantTargetSquare, BoardSquares::e3);
 }
 
 TEST(Board, enPassantTargetSquare_resetsToNegativeOneAfterAnotherMoveIsMade) {
     auto board = Board::fromFenString("rnbqkbnr/pppp1ppp/8/8/3pP3/8/PPP2PPP/RNBQKBNR w KQkq - 0 1");
-    MoveVariant move = NormalMove::fromString("c2c4");
+    auto move = Move::fromString("c2c4");
     board->makeMove(move);
-    MoveVariant move2 = NormalMove::fromString("d7d5");
+    auto move2 = Move::fromString("d7d5");
     board->makeMove(move2);
     ASSERT_EQ(board->enPassantTargetSquare, -1);
 }
@@ -81,7 +128,7 @@ TEST(Board, allCastlesArePossibleBeforeAnyCastlingPiecesMove) {
 TEST(Board, whiteCanNoLongerCastleInAnyDirectionIfTheirKingMoves) {
     auto board = Board::fromFenString("r3k2r/ppp1qppp/2np1n2/2b1p1B1/2B1P1b1/2NP1N2/PPP1QPPP/R3K2R w KQkq - 0 1");
 
-    MoveVariant move = NormalMove::fromString("e1d1");
+    auto move = Move::fromString("e1d1");
     board->makeMove(move);
 
     ASSERT_FALSE(board->canWhiteCastleLeft());
@@ -91,7 +138,7 @@ TEST(Board, whiteCanNoLongerCastleInAnyDirectionIfTheirKingMoves) {
 TEST(Board, whiteCanNoLongerCastleLeftIfTheirLeftRookMoves) {
     auto board = Board::fromFenString("r3k2r/ppp1qppp/2np1n2/2b1p1B1/2B1P1b1/2NP1N2/PPP1QPPP/R3K2R w KQkq - 0 1");
 
-    MoveVariant move = NormalMove::fromString("a1c1");
+    auto move = Move::fromString("a1c1");
     board->makeMove(move);
 
     ASSERT_FALSE(board->canWhiteCastleLeft());
@@ -102,7 +149,7 @@ TEST(Board, whiteCanNoLongerCastleLeftIfTheirLeftRookMoves) {
 TEST(Board, whiteCanNoLongerCastleRightIfTheirRightRookMoves) {
     auto board = Board::fromFenString("r3k2r/ppp1qppp/2np1n2/2b1p1B1/2B1P1b1/2NP1N2/PPP1QPPP/R3K2R w KQkq - 0 1");
 
-    MoveVariant move = NormalMove::fromString("h1f1");
+    auto move = Move::fromString("h1f1");
     board->makeMove(move);
 
     ASSERT_TRUE(board->canWhiteCastleLeft());
@@ -112,7 +159,7 @@ TEST(Board, whiteCanNoLongerCastleRightIfTheirRightRookMoves) {
 TEST(Board, blackCanNoLongerCastleInAnyDirectionIfTheirKingMoves) {
     auto board = Board::fromFenString("r3k2r/ppp1qppp/2np1n2/2b1p1B1/2B1P1b1/2NP1N2/PPP1QPPP/R3K2R w KQkq - 0 1", Piece::Black);
 
-    MoveVariant move = NormalMove::fromString("e8d8");
+    auto move = Move::fromString("e8d8");
     board->makeMove(move);
 
     ASSERT_FALSE(board->canBlackCastleLeft());
@@ -122,7 +169,7 @@ TEST(Board, blackCanNoLongerCastleInAnyDirectionIfTheirKingMoves) {
 TEST(Board, blackCanNoLongerCastleLeftIfTheirLeftRookMoves) {
     auto board = Board::fromFenString("r3k2r/ppp1qppp/2np1n2/2b1p1B1/2B1P1b1/2NP1N2/PPP1QPPP/R3K2R w KQkq - 0 1", Piece::Black);
 
-    MoveVariant move = NormalMove::fromString("a8c8");
+    auto move = Move::fromString("a8c8");
     board->makeMove(move);
 
     ASSERT_FALSE(board->canBlackCastleLeft());
@@ -133,14 +180,142 @@ TEST(Board, blackCanNoLongerCastleLeftIfTheirLeftRookMoves) {
 TEST(Board, blackCanNoLongerCastleRightIfTheirRightRookMoves) {
     auto board = Board::fromFenString("r3k2r/ppp1qppp/2np1n2/2b1p1B1/2B1P1b1/2NP1N2/PPP1QPPP/R3K2R w KQkq - 0 1", Piece::Black);
 
-    MoveVariant move = NormalMove::fromString("h8f8");
+    auto move = Move::fromString("h8f8");
+    board->makeMove(move);
+
+    ASSERT_TRUE(board->canBlackCastleLeft());
+    ASSERT_FALSE(board->canBlackCastleRight());
+}
+
+TEST(Board, blackCanNoLongerCastleRightIfTheirRightRookIsCaptured) {
+    auto board = Board::fromFenString("r3k2r/ppp1qpp1/2np1n2/2b1p1B1/2B1P1b1/2NP1N2/PPP1QPP1/R3K2R w KQkq - 0 1");
+
+    auto move = Move::fromString("h1h8");
     board->makeMove(move);
 
     ASSERT_TRUE(board->canBlackCastleLeft());
     ASSERT_FALSE(board->canBlackCastleRight());
+    ASSERT_FALSE(board->canWhiteCastleRight());
 }
 
 TEST(Board, getZobristHash_isTheSameAs_ZobristHashGenerator_hash) {
     auto board = Board::fromFenString("r3kbnr/ppp1pppp/2n1q3/1B3b2/3P4/2N2N2/PPP2PPP/R1BQK2R b KQk - 0 1");
     ASSERT_EQ(board->getZobristHash(), ZobristHashGenerator.hash(board));
 }
+
+void assertBitboardsMatchSquares(Board *board) {
+    for (int square = 0; square < 64; square++) {
+        auto piece = board->squares[square];
+
+        for (auto colour: {Piece::White, Piece::Black}) {
+            for (int type = Piece::King; type <= Piece::Pawn; type++) {
+                auto isSet = BitboardUtil::contains(board->getPieces(colour, type), square);
+                ASSERT_EQ(isSet, piece == (type | colour));
+            }
+        }
+    }
+}
+
+TEST(Board, bitboardsStayInSyncWithSquares) {
+    auto board = Board::fromFenString("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -");
+    assertBitboardsMatchSquares(board);
+
+    auto moves = board->legalMoves;
+
+    for (auto move: moves) {
+        board->makeMoveWithoutGeneratingMoves(move);
+        assertBitboardsMatchSquares(board);
+        board->unmakeMove(move);
+        assertBitboardsMatchSquares(board);
+    }
+}
+
+TEST(Board, unmakeMoveRestoresKingSquaresAndCastlingRights) {
+    auto board = Board::fromFenString("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -");
+
+    board->makeMoveWithoutGeneratingMoves(Move(BoardSquares::e1, BoardSquares::g1, Move::Castling));
+    EXPECT_EQ(board->getKingSquare(), BoardSquares::e8);
+    EXPECT_EQ(board->getOpponentKingSquare(), BoardSquares::g1);
+    EXPECT_FALSE(board->canWhiteCastleLeft());
+
+    board->unmakeMove(Move(BoardSquares::e1, BoardSquares::g1, Move::Castling));
+    EXPECT_EQ(board->getKingSquare(), BoardSquares::e1);
+    EXPECT_EQ(board->getOpponentKingSquare(), BoardSquares::e8);
+    EXPECT_TRUE(board->canWhiteCastleLeft());
+    EXPECT_EQ(board->getZobristHash(), ZobristHashGenerator.hash(board));
+}
+
+TEST(Board, copyHasTheSamePositionAndMoves) {
+    auto board = Board::fromFenString("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -");
+    board->makeMove(Move::fromString("e1d1"));
+
+    Board copy(*board);
+    EXPECT_EQ(copy.squares, board->squares);
+    EXPECT_EQ(copy.getZobristHash(), board->getZobristHash());
+    EXPECT_EQ(copy.castlingRights, board->castlingRights);
+    EXPECT_EQ(copy.getKingSquare(), board->getKingSquare());
+
+    copy.generateMoves();
+    EXPECT_EQ(copy.legalMoves.size(), board->legalMoves.size());
+    assertBitboardsMatchSquares(&copy);
+}
+
+static const std::string stagedGenerationPositions[]{
+        Board::startPosition,
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - -",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+};
+
+TEST(Board, capturesAndQuietMovesTogetherAreAllLegalMoves) {
+    for (auto &fenString: stagedGenerationPositions) {
+        auto board = Board::fromFenString(fenString);
+        MoveList captures, quietMoves;
+        board->generateCaptures(captures);
+        board->generateQuietMoves(quietMoves);
+
+        EXPECT_EQ(captures.size() + quietMoves.size(), board->legalMoves.size()) << fenString;
+
+        for (auto move: board->legalMoves)
+            EXPECT_TRUE(captures.contains(move) != quietMoves.contains(move)) << fenString << " " << move.toString();
+    }
+}
+
+TEST(Board, pseudoLegalMovesThatPassTheLegalityCheckAreTheLegalMoves) {
+    for (auto &fenString: stagedGenerationPositions) {
+        auto board = Board::fromFenString(fenString);
+        MoveList captures, quietMoves, legalMoves;
+        board->generateCaptures(captures, true);
+        board->generateQuietMoves(quietMoves, true);
+
+        for (auto &moves: {captures, quietMoves})
+            for (auto move: moves)
+                if (board->isPseudoLegalMoveLegal(move)) legalMoves.push(move);
+
+        EXPECT_EQ(legalMoves.size(), board->legalMoves.size()) << fenString;
+
+        for (auto move: board->legalMoves)
+            EXPECT_TRUE(legalMoves.contains(move)) << fenString << " " << move.toString();
+    }
+}
+
+TEST(Board, isLegalAcceptsExactlyTheGeneratedMoves) {
+    const int flagVariants[]{
+            Move::Normal, Move::Capture, Move::Castling, Move::EnPassant | Move::Capture,
+            Move::PromotionToQueen, Move::PromotionToKnight | Move::Capture,
+    };
+
+    for (auto &fenString: stagedGenerationPositions) {
+        auto board = Board::fromFenString(fenString);
+
+        for (int start = 0; start < 64; start++) {
+            for (int target = 0; target < 64; target++) {
+                for (auto flags: flagVariants) {
+                    auto move = Move(start, target, flags);
+                    ASSERT_EQ(board->isLegal(move), board->legalMoves.contains(move)) << fenString << " " << move.toString();
+                }
+            }
+        }
+    }
+}
@@ -6,7 +6,7 @@ int countMoves(Board *board, int depth) {
     if (depth == 0) return 1;
 
     board->generateMoves();
-    std::vector<MoveVariant> moves = board->legalMoves;
+    auto moves = board->legalMoves;
     auto positionsCount = 0;
 
     for (auto move: moves) {
@@ -105,7 +105,7 @@ TEST(MoveCount, BehtingPosition) {
 
 TEST(MoveCount, PositionWhereEnPassantExposesTheKing) {
     Board *board = Board::fromFenString("8/3p1p2/8/r1P1K1Pq/8/8/8/7k", Piece::Black);
-    MoveVariant move = NormalMove(51, 35);
+    Move move(51, 35);
     board->makeMove(move);
 
     ASSERT_EQ(7, countMoves(board, 1));
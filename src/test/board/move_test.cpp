@@ -1,24 +1,61 @@
 #include <gtest/gtest.h>
 #include "../../main/board/piece.h"
 #include "../../main/move/move.h"
+#include "../../main/move/move_list.h"
 #include "../../main/board/board_squares.h"
 
 TEST(Move, FromString) {
-    auto move = NormalMove::fromString("a1b1");
-    EXPECT_EQ(move.startSquare, BoardSquares::a1);
-    EXPECT_EQ(move.targetSquare, BoardSquares::b1);
+    auto move = Move::fromString("a1b1");
+    EXPECT_EQ(move.getStartSquare(), BoardSquares::a1);
+    EXPECT_EQ(move.getTargetSquare(), BoardSquares::b1);
 
-    auto move2 = NormalMove::fromString("d2d4");
-    EXPECT_EQ(move2.startSquare, BoardSquares::d2);
-    EXPECT_EQ(move2.targetSquare, BoardSquares::d4);
+    auto move2 = Move::fromString("d2d4");
+    EXPECT_EQ(move2.getStartSquare(), BoardSquares::d2);
+    EXPECT_EQ(move2.getTargetSquare(), BoardSquares::d4);
 
-    auto move3 = NormalMove::fromString("d7e5");
-    EXPECT_EQ(move3.startSquare, BoardSquares::d7);
-    EXPECT_EQ(move3.targetSquare, BoardSquares::e5);
+    auto move3 = Move::fromString("d7e5");
+    EXPECT_EQ(move3.getStartSquare(), BoardSquares::d7);
+    EXPECT_EQ(move3.getTargetSquare(), BoardSquares::e5);
 }
 
 TEST(Move, ToString) {
-    EXPECT_EQ(NormalMove::fromString("a1b1").toString(), "a1b1");
-    EXPECT_EQ(NormalMove::fromString("d2d4").toString(), "d2d4");
-    EXPECT_EQ(NormalMove::fromString("d7e5").toString(), "d7e5");
+    EXPECT_EQ(Move::fromString("a1b1").toString(), "a1b1");
+    EXPECT_EQ(Move::fromString("d2d4").toString(), "d2d4");
+    EXPECT_EQ(Move::fromString("d7e5").toString(), "d7e5");
+}
+
+TEST(Move, KeepsSquaresAndFlagsInSixteenBits) {
+    static_assert(sizeof(Move) == 2);
+
+    auto promotion = Move::promotion(BoardSquares::g7, BoardSquares::h8, Piece::Knight, true);
+    EXPECT_EQ(promotion.getStartSquare(), BoardSquares::g7);
+    EXPECT_EQ(promotion.getTargetSquare(), BoardSquares::h8);
+    EXPECT_TRUE(promotion.isPromotion());
+    EXPECT_TRUE(promotion.isCapture());
+    EXPECT_EQ(promotion.getPromotionPieceType(), Piece::Knight);
+
+    auto castling = Move(BoardSquares::e1, BoardSquares::c1, Move::Castling);
+    EXPECT_TRUE(castling.isCastling());
+    EXPECT_FALSE(castling.isCapture());
+    EXPECT_EQ(castling.getCastlingRookSquare(), BoardSquares::a1);
+    EXPECT_EQ(castling.getCastlingRookTargetSquare(), BoardSquares::d1);
+
+    auto enPassant = Move(BoardSquares::e5, BoardSquares::d6, Move::EnPassant | Move::Capture);
+    EXPECT_TRUE(enPassant.isEnPassant());
+    EXPECT_EQ(enPassant.getCapturedSquare(), BoardSquares::d5);
+}
+
+TEST(MoveList, MovesTheGivenMoveToTheFront) {
+    MoveList moves;
+    moves.push(Move::fromString("a2a3"));
+    moves.push(Move::fromString("b2b3"));
+    moves.push(Move::fromString("c2c3"));
+
+    moves.moveToFront(Move::fromString("c2c3"));
+    EXPECT_EQ(moves.size(), 3);
+    EXPECT_EQ(moves[0].toString(), "c2c3");
+    EXPECT_EQ(moves[2].toString(), "a2a3");
+
+    moves.moveToFront(Move::fromString("h2h3"));
+    EXPECT_EQ(moves[0].toString(), "c2c3");
 }
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include "../../main/board/board.h"
 #include "../../main/board/zobrist_hash_generator.h"
 #include "../../main/board/board_util.h"
 
@@ -19,12 +20,12 @@ TEST(ZobristHashGenerator, TwoBoardsWithTheSamePositionAreReturnTheSameHash) {
 TEST(ZobristHashGenerator, ConsidersCastlingRights) {
     auto board = Board::fromFenString(Board::startPosition);
     auto originalHash = ZobristHashGenerator.hash(board);
-    board->castlingPieceMoved[Piece::White | Piece::King] = true;
+    board->castlingRights &= ~CastlingRights::White;
     auto hashAfterFirstChange = ZobristHashGenerator.hash(board);
 
     ASSERT_NE(hashAfterFirstChange, originalHash);
 
-    board->castlingPieceMoved[Piece::Black | Piece::RightRook] = true;
+    board->castlingRights &= ~CastlingRights::BlackRight;
 
     ASSERT_NE(ZobristHashGenerator.hash(board), hashAfterFirstChange);
     ASSERT_NE(ZobristHashGenerator.hash(board), originalHash);
@@ -32,7 +33,7 @@ TEST(ZobristHashGenerator, ConsidersCastlingRights) {
 
 TEST(ZobristHashGenerator, BoardWhereEnPassantCanBeMade_HasADifferentHashTo_OneWhereNoEnPassantCanBeMade) {
     auto boardWithEnPassant = Board::fromFenString("rnbqkbnr/pppp1ppp/8/8/3pP3/8/PPP2PPP/RNBQKBNR w KQkq - 0 1");
-    MoveVariant move = NormalMove::fromString("c2c4");
+    auto move = Move::fromString("c2c4");
     boardWithEnPassant->makeMove(move);
 
     auto boardWithoutEnPassant = Board::fromFenString("rnbqkbnr/pppp1ppp/8/8/2PpP3/8/PP3PPP/RNBQKBNR w KQkq - 0 1", Piece::Black);
@@ -42,11 +43,11 @@ TEST(ZobristHashGenerator, BoardWhereEnPassantCanBeMade_HasADifferentHashTo_OneW
 
 TEST(ZobristHashGenerator, TwoDifferentBoardsWithEnPassantMoves_HaveDifferentHashes) {
     auto boardWithEnPassant = Board::fromFenString("rnbqkbnr/pppp1ppp/8/8/3pP3/8/PPP2PPP/RNBQKBNR w KQkq - 0 1");
-    MoveVariant move = NormalMove::fromString("c2c4");
+    auto move = Move::fromString("c2c4");
     boardWithEnPassant->makeMove(move);
 
     auto otherBoardWithEnPassant = Board::fromFenString("rnbqkbnr/pppp1ppp/8/8/2Pp4/8/PP2PPPP/RNBQKBNR w KQkq - 0 1");
-    MoveVariant otherMove = NormalMove::fromString("e2e4");
+    auto otherMove = Move::fromString("e2e4");
     otherBoardWithEnPassant->makeMove(otherMove);
 
     ASSERT_NE(ZobristHashGenerator.hash(boardWithEnPassant), ZobristHashGenerator.hash(otherBoardWithEnPassant));
@@ -57,4 +58,27 @@ TEST(ZobristHashGenerator, TwoBoardsWithTheSamePositionButDifferentPlayerToMoveH
     auto boardWhereBlackMoves = Board::fromFenString(Board::startPosition, Piece::Black);
 
     ASSERT_NE(ZobristHashGenerator.hash(boardWhereWhiteMoves), ZobristHashGenerator.hash(boardWhereBlackMoves));
-}
\ No newline at end of file
+}
+
+void assertIncrementalHashMatchesFullHash(Board *board, int depth) {
+    ASSERT_EQ(board->getZobristHash(), ZobristHashGenerator.hash(board));
+    if (depth == 0) return;
+
+    board->generateMoves();
+    auto moves = board->legalMoves;
+
+    for (auto move: moves) {
+        auto predictedHash = board->getZobristHashAfter(move);
+        board->makeMoveWithoutGeneratingMoves(move);
+        ASSERT_EQ(board->getZobristHash(), predictedHash) << move.toString();
+        assertIncrementalHashMatchesFullHash(board, depth - 1);
+        board->unmakeMove(move);
+        ASSERT_EQ(board->getZobristHash(), ZobristHashGenerator.hash(board));
+    }
+}
+
+TEST(ZobristHashGenerator, IncrementalAndPredictedHashesMatchFullHashAfterMakingAndUnmakingMoves) {
+    // castling, en passant and promotions are all reachable within three plies
+    assertIncrementalHashMatchesFullHash(Board::fromFenString("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -"), 3);
+    assertIncrementalHashMatchesFullHash(Board::fromFenString("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"), 3);
+}